@@ -0,0 +1,163 @@
+#!/usr/bin/python
+"""
+Strong/weak scaling sweeps of the 'scaling' assembly (see src/main/assemblies/ScalingAssembly.h).
+
+For every rank count, framework is run under mpiexec; all runs append their rows to <out>.raw.csv. Then runs are
+summarized: median time for every (algorithm, graph, ranks) with speedup & efficiency relative to the smallest
+rank count, written to <out>.csv and <out>.json.
+
+strong - the same scales for every rank count
+weak   - scale grows by log2(ranks/min_ranks), so that work per rank is constant; speedup is the scaled one
+
+Example:
+    ./scaling.py --binary cmake-build-release/framework --ranks 1,2,4 --scales 14,16 --algos bfs,colouring
+"""
+
+from __future__ import print_function
+
+import argparse
+import csv
+import json
+import math
+import os
+import subprocess
+import sys
+
+
+def parse_list(s):
+    return [x for x in s.split(",") if x]
+
+
+def scales_for(mode, base_scales, ranks, min_ranks):
+    if mode == "strong":
+        return base_scales
+    growth = int(round(math.log(float(ranks)/min_ranks, 2)))
+    return [s + growth for s in base_scales]
+
+
+def run_sweep(args, raw_path):
+    ranks_list = sorted(int(r) for r in parse_list(args.ranks))
+    base_scales = [int(s) for s in parse_list(args.scales)]
+    for ranks in ranks_list:
+        scales = scales_for(args.mode, base_scales, ranks, ranks_list[0])
+        cmd = [args.mpiexec, "-np", str(ranks)] + args.mpiexec_args.split() + [
+            args.binary, "-a", "scaling",
+            "-sc-scales", ",".join(str(s) for s in scales),
+            "-sc-reps", str(args.reps),
+            "-sc-out", raw_path,
+            "-gen", args.gen,
+            "-gen-ef", str(args.edgefactor)]
+        if args.algos:
+            cmd += ["-sc-algos", args.algos]
+        print(" ".join(cmd))
+        with open(os.devnull, "w") as devnull:
+            subprocess.check_call(cmd, stdout=devnull, stderr=devnull if args.quiet else None)
+
+
+def median(values):
+    values = sorted(values)
+    n = len(values)
+    return values[n//2] if n % 2 == 1 else (values[n//2 - 1] + values[n//2])/2.0
+
+
+def summarize(mode, raw_path):
+    runs = {}
+    with open(raw_path) as f:
+        for row in csv.DictReader(f):
+            ranks = int(row["ranks"])
+            scale = int(row["scale"])
+            # rows of the same weak scaling series share the scale of the smallest configuration
+            key = (row["algorithm"], row["graph"], row["edgefactor"])
+            runs.setdefault(key, {}).setdefault((ranks, scale), []).append(row)
+
+    summary = []
+    for (algorithm, graph, edgefactor), by_config in sorted(runs.items()):
+        configs = sorted(by_config.keys())
+        all_ranks = sorted(set(r for r, _ in configs))
+        min_ranks = all_ranks[0]
+
+        for ranks, scale in configs:
+            if mode == "strong":
+                base = (min_ranks, scale)
+            else:
+                growth = int(round(math.log(float(ranks)/min_ranks, 2)))
+                base = (min_ranks, scale - growth)
+            if base not in by_config:
+                continue
+
+            rows = by_config[(ranks, scale)]
+            t = median([float(r["seconds"]) for r in rows])
+            t_base = median([float(r["seconds"]) for r in by_config[base]])
+            relative = float(ranks)/min_ranks
+
+            if mode == "strong":
+                speedup = t_base/t
+                efficiency = speedup/relative
+            else:
+                efficiency = t_base/t
+                speedup = efficiency*relative
+
+            summary.append({
+                "mode": mode,
+                "algorithm": algorithm,
+                "graph": graph,
+                "edgefactor": int(edgefactor),
+                "ranks": ranks,
+                "scale": scale,
+                "repetitions": len(rows),
+                "all_succeeded": all(r["succeeded"] == "1" for r in rows),
+                "median_seconds": t,
+                "median_rank_seconds_max": median([float(r["rank_seconds_max"]) for r in rows]),
+                "median_edges": median([float(r["edges"]) for r in rows]),
+                "median_bytes": median([float(r["bytes"]) for r in rows]),
+                "speedup": speedup,
+                "efficiency": efficiency,
+            })
+
+    return summary
+
+
+def write_summary(summary, out):
+    columns = ["mode", "algorithm", "graph", "edgefactor", "ranks", "scale", "repetitions", "all_succeeded",
+               "median_seconds", "median_rank_seconds_max", "median_edges", "median_bytes", "speedup", "efficiency"]
+    with open(out + ".csv", "w") as f:
+        writer = csv.DictWriter(f, fieldnames=columns)
+        writer.writeheader()
+        for row in summary:
+            writer.writerow(row)
+
+    with open(out + ".json", "w") as f:
+        json.dump(summary, f, indent=2)
+
+    for row in summary:
+        print("{algorithm:>10} {graph} s={scale:<3} p={ranks:<4} t={median_seconds:.6f}s "
+              "speedup={speedup:.2f} efficiency={efficiency:.2f}".format(**row))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Strong/weak scaling sweeps of framework algorithms")
+    parser.add_argument("--binary", default="cmake-build-release/framework")
+    parser.add_argument("--mpiexec", default="mpiexec")
+    parser.add_argument("--mpiexec-args", default="", help="extra arguments passed to mpiexec")
+    parser.add_argument("--mode", choices=["strong", "weak"], default="strong")
+    parser.add_argument("--ranks", default="1,2,4")
+    parser.add_argument("--scales", default="12", help="for weak scaling - scales used with the smallest rank count")
+    parser.add_argument("--algos", default="", help="defaults to all algorithms registered in the assembly")
+    parser.add_argument("--reps", type=int, default=3)
+    parser.add_argument("--gen", default="rmat")
+    parser.add_argument("--edgefactor", type=int, default=16)
+    parser.add_argument("--out", default="scaling")
+    parser.add_argument("--summarize-only", action="store_true", help="don't run anything, reuse <out>.raw.csv")
+    parser.add_argument("--quiet", action="store_true", help="hide framework logs")
+    args = parser.parse_args()
+
+    raw_path = args.out + ".raw.csv"
+    if not args.summarize_only:
+        if os.path.exists(raw_path):
+            os.remove(raw_path)
+        run_sweep(args, raw_path)
+
+    summary = summarize(args.mode, raw_path)
+    if not summary:
+        sys.exit("No complete series in " + raw_path)
+    write_summary(summary, args.out)
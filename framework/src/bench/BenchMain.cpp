@@ -0,0 +1,23 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#include <benchmark/benchmark.h>
+#include <glog/logging.h>
+#include <mpi.h>
+
+/* benchmarks are meant to be run as a single process (mpirun -np 1 or directly) */
+int main(int argc, char* argv[]) {
+	google::InitGoogleLogging(argv[0]);
+	FLAGS_logtostderr = true;
+	/* graph building is quite verbose */
+	FLAGS_minloglevel = 1;
+	MPI_Init(&argc, &argv);
+
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+	benchmark::RunSpecifiedBenchmarks();
+
+	MPI_Finalize();
+	return 0;
+}
@@ -0,0 +1,57 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#ifndef FRAMEWORK_BENCHUTILS_H
+#define FRAMEWORK_BENCHUTILS_H
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <utils/GraphGenerators.h>
+
+namespace BenchUtils {
+	/**
+	 * Writes ER graph (symmetric, without loops and duplicates) in .adjl format to temporary directory and returns
+	 * its path. File is reused if it already exists.
+	 */
+	inline std::string generatedAdjlFile(unsigned scale, unsigned edgeFactor) {
+		std::string path = "/tmp/framework_bench_er_" + std::to_string(scale) + "_" + std::to_string(edgeFactor) +
+		                   ".adjl";
+		if (std::ifstream(path).good()) return path;
+
+		GraphGenerators::Params p;
+		p.kind = GraphGenerators::Kind::ER;
+		p.scale = scale;
+		p.edgeFactor = edgeFactor;
+
+		std::vector<GraphGenerators::Edge> edges;
+		GraphGenerators::generate(p, 0, p.edgeCount(), edges);
+		std::vector<GraphGenerators::Edge> symmetric;
+		for(auto& e: edges) {
+			if (e.first == e.second) continue;
+			symmetric.push_back(e);
+			symmetric.push_back(std::make_pair(e.second, e.first));
+		}
+		std::sort(symmetric.begin(), symmetric.end());
+		symmetric.erase(std::unique(symmetric.begin(), symmetric.end()), symmetric.end());
+
+		std::string tmpPath = path + ".tmp";
+		std::ofstream out(tmpPath);
+		out << p.vertexCount() << "\n" << symmetric.size() << "\n";
+		size_t ei = 0;
+		for(unsigned long long v = 0; v < p.vertexCount(); v++) {
+			out << v;
+			for(; ei < symmetric.size() && symmetric[ei].first == v; ei++) out << " " << symmetric[ei].second;
+			out << "\n";
+		}
+		out.close();
+		std::rename(tmpPath.c_str(), path.c_str());
+
+		return path;
+	}
+}
+
+#endif //FRAMEWORK_BENCHUTILS_H
@@ -0,0 +1,128 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#include <cstdint>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <representations/ArrayBackedChunkedPartition.h>
+#include <representations/AdjacencyListHashPartition.h>
+#include <representations/RoundRobin2DPartition.h>
+#include "BenchUtils.h"
+
+/*
+ * Access paths of graph representations, measured on a single partition holding the whole graph.
+ * RR2D has hard limits on partition size (see details::RR2D), so it uses much smaller graph.
+ */
+
+namespace {
+	const unsigned LARGE_SCALE = 14;
+	const unsigned LARGE_EDGE_FACTOR = 8;
+	const unsigned SMALL_SCALE = 5;
+	const unsigned SMALL_EDGE_FACTOR = 2;
+
+	using ABCP = ABCGraphHandle<int, int>;
+	using ALHP = ALHGraphHandle<uint32_t, uint64_t>;
+	using RR2D = RR2DHandle<int, int>;
+
+	ABCP* abcpHandle(unsigned scale, unsigned ef) {
+		return new ABCP(BenchUtils::generatedAdjlFile(scale, ef), 1, 0, {});
+	}
+
+	ALHP* alhpHandle(unsigned scale, unsigned ef) {
+		return new ALHP(BenchUtils::generatedAdjlFile(scale, ef), {});
+	}
+
+	RR2D* rr2dHandle(unsigned scale, unsigned ef) {
+		return new RR2D(BenchUtils::generatedAdjlFile(scale, ef), {});
+	}
+
+	/* global ids of all edge ends, in iteration order */
+	template <typename G>
+	std::vector<typename G::GidType> collectNeighbours(G& g) {
+		IMPORT_ALIASES(G)
+		std::vector<GlobalId> neighbours;
+		g.foreachMasterVertex([&](const LocalId vid) {
+			g.foreachNeighbouringVertex(vid, [&](const GlobalId nid) {
+				neighbours.push_back(nid);
+				return ITER_PROGRESS::CONTINUE;
+			});
+			return ITER_PROGRESS::CONTINUE;
+		});
+		return neighbours;
+	}
+}
+
+template <typename THandle>
+static void BM_ForeachNeighbouringVertex(benchmark::State& state, THandle* (*factory)(unsigned, unsigned),
+                                         unsigned scale, unsigned ef) {
+	using G = typename THandle::GPType;
+	IMPORT_ALIASES(G)
+
+	auto* h = factory(scale, ef);
+	G& g = h->getGraph();
+
+	size_t edges = 0;
+	for (auto _: state) {
+		edges = 0;
+		g.foreachMasterVertex([&](const LocalId vid) {
+			g.foreachNeighbouringVertex(vid, [&](const GlobalId nid) {
+				benchmark::DoNotOptimize(nid);
+				edges += 1;
+				return ITER_PROGRESS::CONTINUE;
+			});
+			return ITER_PROGRESS::CONTINUE;
+		});
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations()*edges));
+
+	h->releaseGraph();
+	delete h;
+}
+
+template <typename THandle>
+static void BM_ToLocalId(benchmark::State& state, THandle* (*factory)(unsigned, unsigned), unsigned scale, unsigned ef) {
+	using G = typename THandle::GPType;
+
+	auto* h = factory(scale, ef);
+	G& g = h->getGraph();
+	auto neighbours = collectNeighbours(g);
+
+	for (auto _: state) {
+		for(auto nid: neighbours) benchmark::DoNotOptimize(g.toLocalId(nid));
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations()*neighbours.size()));
+
+	h->releaseGraph();
+	delete h;
+}
+
+template <typename THandle>
+static void BM_ToNumeric(benchmark::State& state, THandle* (*factory)(unsigned, unsigned), unsigned scale, unsigned ef) {
+	using G = typename THandle::GPType;
+
+	auto* h = factory(scale, ef);
+	G& g = h->getGraph();
+	auto neighbours = collectNeighbours(g);
+
+	for (auto _: state) {
+		for(auto nid: neighbours) benchmark::DoNotOptimize(g.toNumeric(nid));
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations()*neighbours.size()));
+
+	h->releaseGraph();
+	delete h;
+}
+
+BENCHMARK_CAPTURE(BM_ForeachNeighbouringVertex, ABCP, abcpHandle, LARGE_SCALE, LARGE_EDGE_FACTOR);
+BENCHMARK_CAPTURE(BM_ForeachNeighbouringVertex, ALHP, alhpHandle, LARGE_SCALE, LARGE_EDGE_FACTOR);
+BENCHMARK_CAPTURE(BM_ForeachNeighbouringVertex, ABCP_small, abcpHandle, SMALL_SCALE, SMALL_EDGE_FACTOR);
+BENCHMARK_CAPTURE(BM_ForeachNeighbouringVertex, RR2D_small, rr2dHandle, SMALL_SCALE, SMALL_EDGE_FACTOR);
+
+BENCHMARK_CAPTURE(BM_ToLocalId, ABCP, abcpHandle, LARGE_SCALE, LARGE_EDGE_FACTOR);
+BENCHMARK_CAPTURE(BM_ToLocalId, ALHP, alhpHandle, LARGE_SCALE, LARGE_EDGE_FACTOR);
+BENCHMARK_CAPTURE(BM_ToLocalId, RR2D_small, rr2dHandle, SMALL_SCALE, SMALL_EDGE_FACTOR);
+
+BENCHMARK_CAPTURE(BM_ToNumeric, ABCP, abcpHandle, LARGE_SCALE, LARGE_EDGE_FACTOR);
+BENCHMARK_CAPTURE(BM_ToNumeric, ALHP, alhpHandle, LARGE_SCALE, LARGE_EDGE_FACTOR);
+BENCHMARK_CAPTURE(BM_ToNumeric, RR2D_small, rr2dHandle, SMALL_SCALE, SMALL_EDGE_FACTOR);
@@ -0,0 +1,129 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#include <fstream>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <mpi.h>
+#include <utils/BufferPool.h>
+#include <utils/CsvReader.h>
+#include <utils/MPIAsync.h>
+#include <utils/RequestPool.h>
+#include "BenchUtils.h"
+
+static void BM_CsvReaderParse(benchmark::State& state) {
+	auto path = BenchUtils::generatedAdjlFile(14, 8);
+	std::ifstream f(path, std::ifstream::ate | std::ifstream::binary);
+	auto fileSize = static_cast<int64_t>(f.tellg());
+
+	for (auto _: state) {
+		CsvReader<unsigned long long> reader(path);
+		while(auto line = reader.getNextLine()) {
+			benchmark::DoNotOptimize(line->data());
+		}
+	}
+	state.SetBytesProcessed(state.iterations()*fileSize);
+}
+BENCHMARK(BM_CsvReaderParse);
+
+/* takes one free buffer and gives it back, with given number of buffers in the pool */
+static void BM_BufferPoolGetFree(benchmark::State& state) {
+	BufferPool<std::vector<int>> pool(static_cast<size_t>(state.range(0)));
+
+	for (auto _: state) {
+		std::vector<int>* taken = nullptr;
+		pool.foreachFree([&taken](std::vector<int>* b) {
+			if (taken != nullptr) return false;
+			taken = b;
+			return true;
+		});
+		pool.foreachUsed([taken](std::vector<int>* b) { return b == taken; });
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BufferPoolGetFree)->Arg(1)->Arg(16)->Arg(256);
+
+/* gets given number of buffers, then frees them all */
+static void BM_AutoFreeingBufferGetFree(benchmark::State& state) {
+	auto count = state.range(0);
+	AutoFreeingBuffer<std::vector<int>> buffers(static_cast<size_t>(count), static_cast<size_t>(2*count),
+	                                            [](std::vector<int>*) { return true; },
+	                                            [](std::vector<int>*) {},
+	                                            []() {});
+
+	for (auto _: state) {
+		for(int64_t i = 0; i < count; i++) benchmark::DoNotOptimize(buffers.get());
+		buffers.wait(true);
+	}
+	state.SetItemsProcessed(state.iterations()*count);
+}
+BENCHMARK(BM_AutoFreeingBufferGetFree)->Arg(1)->Arg(16)->Arg(256);
+
+/* sends to itself (matched by receives posted in advance), then recycles both sides */
+static void BM_RequestPoolSendRecycle(benchmark::State& state) {
+	auto count = state.range(0);
+	int rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	RequestPool<int> sends(static_cast<size_t>(count));
+	RequestPool<int> receives(static_cast<size_t>(count));
+
+	for (auto _: state) {
+		for(int64_t i = 0; i < count; i++) {
+			MPI_Request rq;
+			int *r = receives.get();
+			MPI_Irecv(r, 1, MPI_INT, rank, 0, MPI_COMM_WORLD, &rq);
+			receives.submit(r, rq);
+			int *s = sends.get();
+			*s = static_cast<int>(i);
+			MPI_Isend(s, 1, MPI_INT, rank, 0, MPI_COMM_WORLD, &rq);
+			sends.submit(s, rq);
+		}
+		while(sends.inFlight() > 0) sends.testSome();
+		while(receives.inFlight() > 0) receives.testSome();
+	}
+	state.SetItemsProcessed(state.iterations()*count);
+}
+BENCHMARK(BM_RequestPoolSendRecycle)->Arg(16)->Arg(256);
+
+/* tasks without requests - cost of queue management & callback invocation */
+static void BM_MPIAsyncPollImmediate(benchmark::State& state) {
+	auto count = state.range(0);
+	MPIAsync async;
+	size_t executed = 0;
+
+	for (auto _: state) {
+		for(int64_t i = 0; i < count; i++) async.submitTask([&executed]() { executed += 1; });
+		while(async.getQueueSize() > 0) async.pollAll();
+	}
+	benchmark::DoNotOptimize(executed);
+	state.SetItemsProcessed(state.iterations()*count);
+	async.shutdown();
+}
+BENCHMARK(BM_MPIAsyncPollImmediate)->Arg(16)->Arg(1024);
+
+/* requests that never complete - cost of a single pass over pending tasks (one MPI_Test each) */
+static void BM_MPIAsyncPollPending(benchmark::State& state) {
+	auto count = state.range(0);
+	MPIAsync async;
+	int rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	std::vector<int> recvBuffers(static_cast<size_t>(count));
+
+	for(int64_t i = 0; i < count; i++) {
+		auto* rq = new MPI_Request;
+		MPI_Irecv(recvBuffers.data() + i, 1, MPI_INT, rank, static_cast<int>(i), MPI_COMM_WORLD, rq);
+		async.submitWaitingTask(rq, []() {});
+	}
+
+	for (auto _: state) {
+		async.pollAll();
+	}
+	state.SetItemsProcessed(state.iterations()*count);
+
+	/* complete outstanding receives, so that nothing is left pending at MPI_Finalize */
+	int value = 0;
+	for(int64_t i = 0; i < count; i++) MPI_Send(&value, 1, MPI_INT, rank, static_cast<int>(i), MPI_COMM_WORLD);
+	while(async.getQueueSize() > 0) async.pollAll();
+}
+BENCHMARK(BM_MPIAsyncPollPending)->Arg(16)->Arg(1024);
@@ -1,19 +1,33 @@
 #include <cstdio>
 #include <cstdint>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <sstream>
+#include <vector>
 #include <glog/logging.h>
 #include <utils/Config.h>
 #include "Assembly.h"
 #include "Executor.h"
+#include "VariantRegistry.h"
+#include "VariantList.h"
 #include "representations/ArrayBackedChunkedPartition.h"
 #include "representations/AdjacencyListHashPartition.h"
+#include "representations/GeneratedGraphHandle.h"
+#include "representations/RoundRobin2DPartition.h"
 #include "algorithms/colouring/GraphColouringMp.h"
 #include "algorithms/colouring/GraphColouringMpAsync.h"
 #include "algorithms/bfs/Bfs1CommsRound.h"
+#include "algorithms/bfs/BfsFixedMessage.h"
+#include "algorithms/bfs/BfsVarMessage.h"
+#include "algorithms/bfs/MultiSourceBfsBitset.h"
 #include "validators/ColouringValidator.h"
 #include <assemblies/ColouringAssembly.h>
 #include "assemblies/BfsAssembly.h"
 #include <assemblies/RepeatingAssembly.h>
+#include <assemblies/MultiSourceBfsAssembly.h>
+#include <assemblies/Graph500Assembly.h>
+#include <assemblies/ScalingAssembly.h>
 #include "validators/BfsValidator.h"
 
 #define WAIT_FOR_DEBUGGER 0
@@ -23,6 +37,109 @@
 #include <signal.h>
 #endif
 
+/* comma separated list of original vertex ids */
+static std::vector<OriginalVertexId> parseVertexList(std::string list) {
+	std::vector<OriginalVertexId> ids;
+	std::stringstream ss(list);
+	std::string item;
+	while(std::getline(ss, item, ',')) {
+		if (!item.empty()) ids.push_back(std::stoull(item));
+	}
+	return ids;
+}
+
+/* bfs, colouring & msbfs in all their variants, on graphs of given handle type */
+template <typename THandle>
+static void registerRepresentation(VariantRegistry& registry, std::string repr, std::string ids) {
+	std::function<THandle*(const HandleArgs&)> create = [](const HandleArgs& a) {
+		return createHandle(a, static_cast<THandle*>(nullptr));
+	};
+
+	#define REGISTER_BFS(variant, TAlgo) \
+		registry.add<THandle>("bfs", repr, ids, variant, create, [](THandle& h) { \
+			return new BfsAssembly<TAlgo, THandle>(h); \
+		});
+	#define REGISTER_COLOURING(variant, TAlgo) \
+		registry.add<THandle>("colouring", repr, ids, variant, create, [](THandle& h) { \
+			return new ColouringAssembly<TAlgo, THandle>(h); \
+		});
+	#define REGISTER_MSBFS(variant, TAlgo) \
+		registry.add<THandle>("msbfs", repr, ids, variant, create, [](THandle& h) { \
+			return new MultiSourceBfsAssembly<TAlgo, THandle>(h); \
+		});
+	FRAMEWORK_BFS_VARIANTS(REGISTER_BFS)
+	FRAMEWORK_COLOURING_VARIANTS(REGISTER_COLOURING)
+	FRAMEWORK_MSBFS_VARIANTS(REGISTER_MSBFS)
+	#undef REGISTER_BFS
+	#undef REGISTER_COLOURING
+	#undef REGISTER_MSBFS
+}
+
+/* graph500 needs generator parameters, so it's available only for generated graphs */
+template <typename THandle>
+static void registerGenerated(VariantRegistry& registry, std::string ids) {
+	registerRepresentation<THandle>(registry, "gen", ids);
+
+	std::function<THandle*(const HandleArgs&)> create = [](const HandleArgs& a) {
+		return createHandle(a, static_cast<THandle*>(nullptr));
+	};
+	#define REGISTER_GRAPH500(variant, TAlgo) \
+		registry.add<THandle>("graph500", "gen", ids, variant, create, [](THandle& h) { \
+			return new Graph500Assembly<TAlgo, THandle>(h); \
+		});
+	FRAMEWORK_BFS_VARIANTS(REGISTER_GRAPH500)
+	#undef REGISTER_GRAPH500
+}
+
+/**
+ * Selected with -repr, -ids and -variant (see details::Variants); e.g. -a bfs -repr abcp -ids 64 -variant fixed.
+ * Combinations are listed in VariantList.h.
+ *
+ * repr:    alh, rr2d, abcp (loaded from -g), gen (ABCP generated in memory, see GraphGenerators for options)
+ * ids:     32, 64 (local id width; numeric ids are always 64 bit), packed (64 bit local ids in 64 bit global ids,
+ *          abcp & gen only), auto (narrowest one that fits the graph)
+ * variant: bfs & graph500 - 1tag, 2rounds, fixed; colouring - mp, async; msbfs - bitset
+ */
+static void registerVariants(VariantRegistry& registry) {
+	using namespace details::Variants;
+
+	#define REGISTER_LOADED(repr, ids, ...) registerRepresentation<__VA_ARGS__>(registry, repr, ids);
+	#define REGISTER_GENERATED(repr, ids, ...) registerGenerated<__VA_ARGS__>(registry, ids);
+	FRAMEWORK_LOADED_HANDLES(REGISTER_LOADED)
+	FRAMEWORK_GENERATED_HANDLES(REGISTER_GENERATED)
+	#undef REGISTER_LOADED
+	#undef REGISTER_GENERATED
+
+	registry.setDefaultIds("alh", "32");
+	registry.setDefaultIds("rr2d", "32");
+	registry.setDefaultIds("abcp", "32");
+	registry.setDefaultIds("gen", "64");
+
+	registry.setAssemblyDefaults("bfs", {{REPRESENTATION_OPT, "alh"}, {VARIANT_OPT, "1tag"}});
+	registry.setAssemblyDefaults("colouring", {{REPRESENTATION_OPT, "alh"}, {VARIANT_OPT, "mp"}});
+	registry.setAssemblyDefaults("msbfs", {{REPRESENTATION_OPT, "alh"}, {VARIANT_OPT, "bitset"}});
+	registry.setAssemblyDefaults("graph500", {{REPRESENTATION_OPT, "gen"}, {VARIANT_OPT, "1tag"}});
+
+	/* names used before variants could be selected */
+	registry.addAlias("gen-bfs", "bfs", {{REPRESENTATION_OPT, "gen"}});
+	registry.addAlias("gen-colouring", "colouring", {{REPRESENTATION_OPT, "gen"}});
+	registry.addAlias("gen-msbfs", "msbfs", {{REPRESENTATION_OPT, "gen"}});
+	registry.addAlias("gen-bfs-packed", "bfs", {{REPRESENTATION_OPT, "gen"}, {IDS_OPT, "packed"}});
+	registry.addAlias("graph500-packed", "graph500", {{IDS_OPT, "packed"}});
+}
+
+/* for ids=auto - 32 bit local ids unless graph has more vertices than they can address */
+static std::string narrowestIds(const std::string& repr, const HandleArgs& args) {
+	unsigned long long vertexCount = 0;
+	if (repr == "gen") {
+		vertexCount = GraphGenerators::Params::fromConfig(args.config).vertexCount();
+	} else {
+		AdjacencyListReader<OriginalVertexId> reader(args.graphPath);
+		vertexCount = reader.getVertexCount();
+	}
+	return (vertexCount <= std::numeric_limits<uint32_t>::max()) ? "32" : "64";
+}
+
 int main(const int argc, const char** argv) {
 	FLAGS_logtostderr = true;
 	FLAGS_v = 4;
@@ -42,22 +159,64 @@ int main(const int argc, const char** argv) {
 
 	auto assemblyName = cm["a"];
 	auto graphFilePath = cm["g"];
+	/* bfs uses only the first one, msbfs - all of them */
+	std::vector<OriginalVertexId> roots = {0L};
+	if (cm.find("roots") != cm.end())
+		roots = parseVertexList(cm["roots"]);
 	
 	Executor executor(cm);
-	
-	GBAuxiliaryParams gbAuxParams;
-	gbAuxParams.configMap = cm;
-	using THandle = ALHGraphHandle<uint32_t, uint64_t>;
-	auto *graphHandle = new THandle(graphFilePath, {0L}, gbAuxParams);
 
-	executor.registerAssembly("colouring", new ColouringAssembly<GraphColouringMp, THandle>(*graphHandle));
-	executor.registerAssembly("bfs", new BfsAssembly<Bfs_Mp_VarMsgLen_1D_1CommsTag, THandle>(*graphHandle));
+	int rank, size;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+	HandleArgs handleArgs;
+	handleArgs.config = cm;
+	handleArgs.graphPath = graphFilePath;
+	handleArgs.roots = roots;
+	handleArgs.rank = rank;
+	handleArgs.size = size;
+
+	VariantRegistry registry;
+	registerVariants(registry);
+
 	executor.registerAssembly("repeating", new RepeatingAssembly());
+	/* repeating runs another assembly, which must be registered as well */
+	std::vector<std::string> selected = {assemblyName};
+	if (cm.find(details::RepeatingAssembly::NAME_OPT) != cm.end())
+		selected.push_back(cm[details::RepeatingAssembly::NAME_OPT]);
+	for(auto& name: selected) {
+		auto resolved = registry.resolveOptions(name, cm);
+		if (resolved.second[details::Variants::IDS_OPT] == "auto") {
+			auto ids = narrowestIds(resolved.second[details::Variants::REPRESENTATION_OPT], handleArgs);
+			LOG(INFO) << "Using " << ids << " bit ids";
+			handleArgs.config[details::Variants::IDS_OPT] = ids;
+		}
+
+		Assembly* assembly = registry.create(name, handleArgs);
+		if (assembly != nullptr) {
+			LOG(INFO) << "Selected " << registry.resolve(name, handleArgs.config);
+			executor.registerAssembly(name, assembly);
+		}
+	}
+
+	/* graphs are generated by the assembly itself, one per scale (see ScalingAssembly & scaling.py) */
+	using TGenHandle = ABCGeneratedGraphHandle<LocalVertexId, NumericIdRepr>;
+	using TGenGraph = TGenHandle::GPType;
+	auto *scaling = new ScalingAssembly<TGenHandle>(GraphGenerators::Params::fromConfig(cm));
+	scaling->addAlgorithm("bfs", ScalingRuns::bfs<Bfs_Mp_VarMsgLen_1D_1CommsTag, TGenGraph>());
+	scaling->addAlgorithm("msbfs", ScalingRuns::multiSourceBfs<MsBfs_Mp_Bitset_1D, TGenGraph>(details::multiSource::MAX_ROOTS));
+	scaling->addAlgorithm("colouring", ScalingRuns::defaultConstructed<GraphColouringMp, TGenGraph>());
+	executor.registerAssembly("scaling", scaling);
 
 	if(assemblyName.empty() || !executor.executeAssembly(assemblyName)) {
-		std::cout << "Assembly with name '" << assemblyName << "' not found!" << std::endl;
+		std::cout << "Assembly '" << assemblyName << "' not found for " << registry.resolve(assemblyName, cm)
+		          << "! Available (assembly:repr:ids:variant):" << std::endl;
+		for(auto& key: registry.keys()) std::cout << "  " << key << std::endl;
+		std::cout << "Aliases:";
+		for(auto& alias: registry.aliasNames()) std::cout << " " << alias;
+		std::cout << std::endl;
 	}
 
-	delete graphHandle;
 	return 0;
 }
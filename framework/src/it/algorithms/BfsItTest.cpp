@@ -4,6 +4,7 @@
 #include <Executor.h>
 #include <Assembly.h>
 #include <representations/AdjacencyListHashPartition.h>
+#include <representations/GeneratedGraphHandle.h>
 #include <algorithms/bfs/Bfs1CommsRound.h>
 #include <algorithms/bfs/BfsFixedMessage.h>
 #include <algorithms/bfs/BfsVarMessage.h>
@@ -34,6 +35,17 @@ static void executeTest(std::string graphPath, ull originalRootId)
 	delete graphHandle;
 }
 
+/* graph large enough for the levels to span many messages */
+template <template<typename> class TAlgo, typename GGH = ABCGeneratedGraphHandle<int, int>>
+static void executeGeneratedTest(unsigned int scale, unsigned int edgeFactor, ConfigMap cm = ConfigMap())
+{
+	using A = BfsAssembly<TAlgo, GGH>;
+	runOnGeneratedGraph<A, GGH>(scale, edgeFactor, cm, {0}, [](A& assembly) {
+		ASSERT_TRUE(assembly.algorithmSucceeded);
+		ASSERT_TRUE(assembly.validationSucceeded);
+	});
+}
+
 
 TEST(Bfs_Mp_FixedMsgLen_1D_2CommRounds, FindsCorrectSolutionForSTG) {
 	executeTest<GH, Bfs_Mp_FixedMsgLen_1D_2CommRounds>("resources/test/SimpleTestGraph.adjl", 0);
@@ -43,6 +55,10 @@ TEST(Bfs_Mp_FixedMsgLen_1D_2CommRounds, FindsCorrectSolutionForComplete50) {
 	executeTest<GH, Bfs_Mp_FixedMsgLen_1D_2CommRounds>("resources/test/complete50.adjl", 0);
 }
 
+TEST(Bfs_Mp_FixedMsgLen_1D_2CommRounds, FindsCorrectSolutionWhenLevelSpansManyChunks) {
+	executeGeneratedTest<Bfs_Mp_FixedMsgLen_1D_2CommRounds>(11, 16);
+}
+
 TEST(Bfs_Mp_VarMsgLen_1D_2CommRounds, FindsCorrectSolutionForSTG) {
 	executeTest<GH, Bfs_Mp_VarMsgLen_1D_2CommRounds>("resources/test/SimpleTestGraph.adjl", 0);
 }
@@ -55,6 +71,23 @@ TEST(Bfs_Mp_VarMsgLen_1D_1CommsTag, FindsCorrectSolutionForSTG) {
 	executeTest<GH, Bfs_Mp_VarMsgLen_1D_1CommsTag>("resources/test/SimpleTestGraph.adjl", 0);
 }
 
+TEST(Bfs_Mp_VarMsgLen_1D_1CommsTag, FindsCorrectSolutionWithPackedGlobalIds) {
+	using PackedGH = ABCGeneratedGraphHandle<LocalVertexId, NumericIdRepr, ABCPPackedGlobalVertexId<>>;
+	executeGeneratedTest<Bfs_Mp_VarMsgLen_1D_1CommsTag, PackedGH>(10, 16);
+}
+
+TEST(Bfs_Mp_VarMsgLen_1D_1CommsTag, FindsCorrectSolutionWhenMessagesOverflowReceiveBuffers) {
+	ConfigMap cm;
+	cm.emplace(details::varLength::RECEIVE_CAPACITY_OPT, "1");
+	executeGeneratedTest<Bfs_Mp_VarMsgLen_1D_1CommsTag>(11, 16, cm);
+}
+
+TEST(Bfs_Mp_VarMsgLen_1D_1CommsTag, FindsCorrectSolutionWithSharedMemory) {
+	ConfigMap cm;
+	cm.emplace(details::SharedMemory::ENABLED_OPT, "1");
+	executeGeneratedTest<Bfs_Mp_VarMsgLen_1D_1CommsTag>(11, 16, cm);
+}
+
 TEST(Bfs_Mp_VarMsgLen_1D_1CommsTag, FindsCorrectSolutionForComplete50) {
 	executeTest<GH, Bfs_Mp_VarMsgLen_1D_1CommsTag>("resources/test/complete50.adjl", 0);
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <Executor.h>
 #include <Assembly.h>
 #include <representations/AdjacencyListHashPartition.h>
+#include <representations/GeneratedGraphHandle.h>
 #include <algorithms/colouring/GraphColouringMp.h>
 #include <algorithms/colouring/GraphColouringMpAsync.h>
 #include <assemblies/ColouringAssembly.h>
@@ -34,6 +35,35 @@ static void executeTest(std::string graphPath)
 	delete graphHandle;
 }
 
+template <template<typename> class TAlgo>
+static void executeGeneratedTest(ConfigMap cm)
+{
+	using GGH = ABCGeneratedGraphHandle<int, int>;
+	using A = ColouringAssembly<TAlgo, GGH>;
+	runOnGeneratedGraph<A, GGH>(9, 8, cm, {}, [](A& assembly) {
+		ASSERT_TRUE(assembly.algorithmSucceeded);
+		ASSERT_TRUE(assembly.validationSucceeded);
+	});
+}
+
+/* colouring of generated graph with vertices ordered by given priority */
+template <template<typename> class TAlgo>
+static void executeGeneratedTest(std::string priority)
+{
+	ConfigMap cm;
+	cm.emplace(details::ColouringPriority::PRIORITY_OPT, priority);
+	executeGeneratedTest<TAlgo>(cm);
+}
+
+/* the smallest flow control budget, so that senders run out of credits */
+template <template<typename> class TAlgo>
+static void executeCreditStarvedTest()
+{
+	ConfigMap cm;
+	cm.emplace(details::FlowControl::BUDGET_OPT, "0");
+	executeGeneratedTest<TAlgo>(cm);
+}
+
 TEST(ColouringMPAsync, FindsCorrectSolutionForSTG) {
 	executeTest<GH, GraphColouringMPAsync>("resources/test/SimpleTestGraph.adjl");
 }
@@ -49,3 +79,31 @@ TEST(ColouringMP, FindsCorrectSolutionForSTG) {
 TEST(ColouringMP, FindsCorrectSolutionForComplete50) {
 	executeTest<GH, GraphColouringMp>("resources/test/complete50.adjl");
 }
+
+TEST(ColouringMPPriorities, FindsCorrectSolutionOrderedById) {
+	executeGeneratedTest<GraphColouringMp>("id");
+}
+
+TEST(ColouringMPPriorities, FindsCorrectSolutionOrderedByDegree) {
+	executeGeneratedTest<GraphColouringMp>("degree");
+}
+
+TEST(ColouringMPPriorities, FindsCorrectSolutionOrderedRandomly) {
+	executeGeneratedTest<GraphColouringMp>("random");
+}
+
+TEST(ColouringMPPriorities, FindsCorrectSolutionOrderedSmallestLast) {
+	executeGeneratedTest<GraphColouringMp>("sl");
+}
+
+TEST(ColouringMPAsyncPriorities, FindsCorrectSolutionOrderedSmallestLast) {
+	executeGeneratedTest<GraphColouringMPAsync>("sl");
+}
+
+TEST(ColouringMPCredits, FindsCorrectSolutionWithSmallBudget) {
+	executeCreditStarvedTest<GraphColouringMp>();
+}
+
+TEST(ColouringMPAsyncCredits, FindsCorrectSolutionWithSmallBudget) {
+	executeCreditStarvedTest<GraphColouringMPAsync>();
+}
@@ -0,0 +1,30 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <utils/TestUtils.h>
+#include <Executor.h>
+#include <representations/GeneratedGraphHandle.h>
+#include <algorithms/bfs/Bfs1CommsRound.h>
+#include <algorithms/bfs/BfsVarMessage.h>
+#include <assemblies/Graph500Assembly.h>
+
+using GH = ABCGeneratedGraphHandle<int, int>;
+
+template <template<typename> class TAlgo>
+static void executeTest(unsigned int scale, unsigned int edgeFactor, std::string rootsCount)
+{
+	using A = Graph500Assembly<TAlgo, GH>;
+	ConfigMap cm;
+	cm.emplace(details::Graph500::ROOTS_COUNT_OPT, rootsCount);
+	runOnGeneratedGraph<A, GH>(scale, edgeFactor, cm, {}, [](A& assembly) {
+		ASSERT_TRUE(assembly.allValid);
+	});
+}
+
+TEST(Graph500Assembly, ValidatesAllRootsOnSmallKronecker) {
+	executeTest<Bfs_Mp_VarMsgLen_1D_1CommsTag>(8, 16, "8");
+}
+
+TEST(Graph500Assembly, ValidatesAllRootsOnSparseKronecker) {
+	/* sparse graph has many isolated vertices & small components */
+	executeTest<Bfs_Mp_VarMsgLen_1D_2CommRounds>(9, 2, "16");
+}
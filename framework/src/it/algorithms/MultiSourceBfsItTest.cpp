@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <utils/TestUtils.h>
+#include <Executor.h>
+#include <Assembly.h>
+#include <representations/ArrayBackedChunkedPartition.h>
+#include <algorithms/bfs/MultiSourceBfsBitset.h>
+#include <assemblies/MultiSourceBfsAssembly.h>
+
+using GH = ABCGraphHandle<int, int>;
+
+template <typename TGraphBuilder, template<typename> class TAlgo>
+static void executeTest(std::string graphPath, std::vector<OriginalVertexId> roots)
+{
+	int rank, size;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+	ConfigMap cm;
+	auto *graphHandle = new TGraphBuilder(graphPath, size, rank, roots);
+
+	Executor executor(cm, false);
+
+	auto* assembly = new MultiSourceBfsAssembly<TAlgo, TGraphBuilder>(*graphHandle);
+	executor.registerAssembly("t", assembly);
+	executor.executeAssembly("t");
+
+	ASSERT_TRUE(assembly->algorithmSucceeded);
+	ASSERT_TRUE(assembly->validationSucceeded);
+
+	delete graphHandle;
+}
+
+TEST(MsBfs_Mp_Bitset_1D, FindsCorrectSolutionForSTG) {
+	executeTest<GH, MsBfs_Mp_Bitset_1D>("resources/test/SimpleTestGraph.adjl", {0, 1, 2, 3});
+}
+
+TEST(MsBfs_Mp_Bitset_1D, FindsCorrectSolutionForComplete50) {
+	executeTest<GH, MsBfs_Mp_Bitset_1D>("resources/test/complete50.adjl", {0, 7, 25, 49});
+}
+
+TEST(MsBfs_Mp_Bitset_1D, FindsCorrectSolutionForPowerlawWithDuplicatedRoots) {
+	executeTest<GH, MsBfs_Mp_Bitset_1D>("resources/test/powerlaw_25_2_05_876.adjl", {0, 3, 3, 11, 24});
+}
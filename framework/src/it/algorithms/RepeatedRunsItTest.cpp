@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <utils/TestUtils.h>
+#include <Executor.h>
+#include <Assembly.h>
+#include <VariantRegistry.h>
+#include <representations/GeneratedGraphHandle.h>
+#include <algorithms/bfs/Bfs1CommsRound.h>
+#include <algorithms/colouring/GraphColouringMp.h>
+#include <assemblies/BfsAssembly.h>
+#include <assemblies/ColouringAssembly.h>
+#include <assemblies/RepeatingAssembly.h>
+
+using GH = ABCGeneratedGraphHandle<int, int>;
+
+template <typename TAssembly>
+static void executeTest(ConfigMap cm, size_t expectedIterations) {
+	int rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	runOnGeneratedGraph<TAssembly, GH>(8, 8, cm, {0}, [&](TAssembly& assembly) {
+		ASSERT_TRUE(assembly.algorithmSucceeded);
+		ASSERT_TRUE(assembly.validationSucceeded);
+		if (rank == 0) {
+			ASSERT_EQ(assembly.iterationTimes.size(), expectedIterations);
+		}
+	});
+}
+
+TEST(RepeatedRuns, ColouringIsCorrectInEveryIteration) {
+	ConfigMap cm;
+	cm.emplace(details::Assemblies::ITERATIONS_OPT, "3");
+	cm.emplace(details::Assemblies::WARMUP_OPT, "1");
+	cm.emplace(details::Assemblies::VALIDATE_ALL_OPT, "1");
+	executeTest<ColouringAssembly<GraphColouringMp, GH>>(cm, 3);
+}
+
+TEST(RepeatedRuns, BfsValidatesFirstIteration) {
+	ConfigMap cm;
+	cm.emplace(details::Assemblies::ITERATIONS_OPT, "4");
+	executeTest<BfsAssembly<Bfs_Mp_VarMsgLen_1D_1CommsTag, GH>>(cm, 4);
+}
+
+TEST(RepeatedRuns, RepeatingAssemblyReusesGraph) {
+	int rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	auto *graphHandle = generatedGraphHandle<GH>(8, 8, {0});
+
+	ConfigMap cm;
+	cm.emplace(details::RepeatingAssembly::N_OPT, "2");
+	cm.emplace(details::RepeatingAssembly::NAME_OPT, "colouring");
+	Executor executor(cm, false);
+	auto* colouring = new ColouringAssembly<GraphColouringMp, GH>(*graphHandle);
+	executor.registerAssembly("colouring", colouring);
+	executor.registerAssembly("repeating", new RepeatingAssembly());
+	executor.executeAssembly("repeating");
+
+	ASSERT_TRUE(colouring->algorithmSucceeded);
+	ASSERT_TRUE(colouring->validationSucceeded);
+	if (rank == 0) {
+		ASSERT_EQ(colouring->iterationTimes.size(), 2);
+	}
+
+	delete graphHandle;
+}
+
+TEST(RepeatedRuns, RepeatingAssemblyIteratesAssemblyCreatedByRegistry) {
+	int rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+	using A = BfsAssembly<Bfs_Mp_VarMsgLen_1D_1CommsTag, GH>;
+	A* bfs = nullptr;
+	VariantRegistry registry;
+	registry.add<GH>("bfs", "gen", "32", "1tag",
+	                 [](const HandleArgs&) { return generatedGraphHandle<GH>(8, 8, {0}); },
+	                 [&bfs](GH& h) { return bfs = new A(h); });
+
+	ConfigMap cm;
+	cm.emplace(details::RepeatingAssembly::N_OPT, "2");
+	cm.emplace(details::RepeatingAssembly::NAME_OPT, "bfs");
+	HandleArgs args;
+	args.config = cm;
+	args.config.emplace(details::Variants::REPRESENTATION_OPT, "gen");
+	args.config.emplace(details::Variants::IDS_OPT, "32");
+	args.config.emplace(details::Variants::VARIANT_OPT, "1tag");
+
+	Executor executor(cm, false);
+	executor.registerAssembly("bfs", registry.create("bfs", args));
+	executor.registerAssembly("repeating", new RepeatingAssembly());
+	executor.executeAssembly("repeating");
+
+	ASSERT_TRUE(bfs->algorithmSucceeded);
+	ASSERT_TRUE(bfs->validationSucceeded);
+	if (rank == 0) {
+		ASSERT_EQ(bfs->iterationTimes.size(), 2);
+	}
+}
+
+namespace {
+	class CountingAssembly : public Assembly {
+	public:
+		int runs = 0;
+
+	protected:
+		void doRun(ConfigMap) override {
+			runs++;
+		}
+	};
+}
+
+TEST(RepeatedRuns, RepeatingAssemblyRejectsIterationsOfNonAlgorithmAssembly) {
+	ConfigMap cm;
+	cm.emplace(details::RepeatingAssembly::N_OPT, "2");
+	cm.emplace(details::RepeatingAssembly::NAME_OPT, "counting");
+	Executor executor(cm, false);
+	auto* counting = new CountingAssembly();
+	executor.registerAssembly("counting", counting);
+	executor.registerAssembly("repeating", new RepeatingAssembly());
+	ASSERT_THROW(executor.executeAssembly("repeating"), std::runtime_error);
+	ASSERT_EQ(counting->runs, 0);
+
+	cm.emplace(details::RepeatingAssembly::RELOAD_OPT, "1");
+	executor.executeAssembly("repeating", cm);
+	ASSERT_EQ(counting->runs, 2);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <cstdio>
+#include <fstream>
+#include <Executor.h>
+#include <representations/GeneratedGraphHandle.h>
+#include <algorithms/bfs/Bfs1CommsRound.h>
+#include <algorithms/bfs/MultiSourceBfsBitset.h>
+#include <algorithms/colouring/GraphColouringMp.h>
+#include <assemblies/ScalingAssembly.h>
+
+using GH = ABCGeneratedGraphHandle<int, int>;
+using G = GH::GPType;
+
+TEST(ScalingAssembly, WritesRowForEachRun) {
+	int rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+	const std::string outPath = "/tmp/framework_scaling_it.csv";
+	if (rank == 0) std::remove(outPath.c_str());
+
+	ConfigMap cm;
+	cm.emplace(details::Scaling::SCALES_OPT, "6,7");
+	cm.emplace(details::Scaling::REPETITIONS_OPT, "2");
+	cm.emplace(details::Scaling::OUTPUT_OPT, outPath);
+	Executor executor(cm, false);
+
+	GraphGenerators::Params params;
+	params.edgeFactor = 8;
+	auto* assembly = new ScalingAssembly<GH>(params);
+	assembly->addAlgorithm("bfs", ScalingRuns::bfs<Bfs_Mp_VarMsgLen_1D_1CommsTag, G>());
+	assembly->addAlgorithm("msbfs", ScalingRuns::multiSourceBfs<MsBfs_Mp_Bitset_1D, G>(4));
+	assembly->addAlgorithm("colouring", ScalingRuns::defaultConstructed<GraphColouringMp, G>());
+	executor.registerAssembly("t", assembly);
+	executor.executeAssembly("t");
+
+	ASSERT_TRUE(assembly->allSucceeded);
+
+	if (rank == 0) {
+		std::ifstream in(outPath);
+		std::string line;
+		std::getline(in, line);
+		ASSERT_EQ(line, details::Scaling::CSV_HEADER);
+
+		size_t rows = 0;
+		while(std::getline(in, line)) {
+			auto fields = details::Scaling::splitList(line);
+			ASSERT_EQ(fields.size(), 14);
+			/* succeeded */
+			ASSERT_EQ(fields[6], "1");
+			/* both BFS kinds are instrumented, so they must report traversed edges */
+			if (fields[4] != "colouring") {
+				ASSERT_GT(std::stod(fields[11]), 0.0);
+			}
+			rows += 1;
+		}
+		/* 2 scales x 3 algorithms x 2 repetitions */
+		ASSERT_EQ(rows, 12);
+	}
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <algorithm>
+#include <vector>
+#include <representations/GeneratedGraphHandle.h>
+
+using GH = ABCGeneratedGraphHandle<int, int>;
+
+namespace {
+	/* all edges of the graph, as numeric ids, gathered on every node */
+	std::vector<std::pair<int, int>> gatherEdges(GH::GPType& g) {
+		int size;
+		MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+		std::vector<int> local;
+		g.foreachMasterVertex([&](const int vid) {
+			g.foreachNeighbouringVertex(vid, [&](const GH::GPType::GidType nid) {
+				local.push_back(static_cast<int>(g.toNumeric(vid)));
+				local.push_back(static_cast<int>(g.toNumeric(nid)));
+				return ITER_PROGRESS::CONTINUE;
+			});
+			return ITER_PROGRESS::CONTINUE;
+		});
+
+		int localCount = static_cast<int>(local.size());
+		std::vector<int> counts(size), displs(size);
+		MPI_Allgather(&localCount, 1, MPI_INT, counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+		int total = 0;
+		for(int i = 0; i < size; i++) {
+			displs[i] = total;
+			total += counts[i];
+		}
+		std::vector<int> all(total);
+		MPI_Allgatherv(local.data(), localCount, MPI_INT, all.data(), counts.data(), displs.data(), MPI_INT, MPI_COMM_WORLD);
+
+		std::vector<std::pair<int, int>> edges;
+		for(int i = 0; i < total; i += 2) edges.push_back(std::make_pair(all[i], all[i+1]));
+		std::sort(edges.begin(), edges.end());
+		return edges;
+	}
+}
+
+static void checkSymmetricWithoutLoopsAndDuplicates(GraphGenerators::Kind kind) {
+	int rank, size;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+	GraphGenerators::Params params;
+	params.kind = kind;
+	params.scale = 8;
+	params.edgeFactor = 8;
+	GH handle(params, size, rank, {0});
+
+	auto edges = gatherEdges(handle.getGraph());
+	ASSERT_FALSE(edges.empty());
+	ASSERT_TRUE(std::adjacent_find(edges.begin(), edges.end()) == edges.end());
+	for(auto& e: edges) {
+		ASSERT_NE(e.first, e.second);
+		ASSERT_TRUE(std::binary_search(edges.begin(), edges.end(), std::make_pair(e.second, e.first)));
+		ASSERT_LT(e.first, 256);
+		ASSERT_LT(e.second, 256);
+	}
+}
+
+TEST(ABCGeneratedGraphHandle, RmatGraphIsSymmetricWithoutLoopsAndDuplicates) {
+	checkSymmetricWithoutLoopsAndDuplicates(GraphGenerators::Kind::RMAT);
+}
+
+TEST(ABCGeneratedGraphHandle, ErGraphIsSymmetricWithoutLoopsAndDuplicates) {
+	checkSymmetricWithoutLoopsAndDuplicates(GraphGenerators::Kind::ER);
+}
+
+TEST(ABCGeneratedGraphHandle, PowerLawGraphIsSymmetricWithoutLoopsAndDuplicates) {
+	checkSymmetricWithoutLoopsAndDuplicates(GraphGenerators::Kind::POWERLAW);
+}
+
+TEST(ABCGeneratedGraphHandle, GraphDoesNotDependOnPartitionCount) {
+	int rank, size;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+	GraphGenerators::Params params;
+	params.kind = GraphGenerators::Kind::POWERLAW;
+	params.scale = 7;
+	params.edgeFactor = 4;
+	params.seed = 42;
+	GH handle(params, size, rank, {});
+	auto edges = gatherEdges(handle.getGraph());
+
+	/* generate the whole graph locally */
+	std::vector<GraphGenerators::Edge> generated;
+	GraphGenerators::generate(params, 0, params.edgeCount(), generated);
+	std::vector<std::pair<int, int>> expected;
+	for(auto& e: generated) {
+		if (e.first == e.second) continue;
+		expected.push_back(std::make_pair(static_cast<int>(e.first), static_cast<int>(e.second)));
+		expected.push_back(std::make_pair(static_cast<int>(e.second), static_cast<int>(e.first)));
+	}
+	std::sort(expected.begin(), expected.end());
+	expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+
+	ASSERT_EQ(edges, expected);
+}
+
+TEST(ABCGeneratedGraphHandle, GraphDoesNotDependOnExchangeChunk) {
+	int rank, size;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+	GraphGenerators::Params params;
+	params.scale = 7;
+	params.edgeFactor = 4;
+	GH handle(params, size, rank, {});
+
+	/* a single edge per peer in each round */
+	GBAuxiliaryParams auxParams;
+	auxParams.configMap.emplace(GH::EXCHANGE_CHUNK_OPT, "3");
+	GH chunkedHandle(params, size, rank, {}, auxParams);
+
+	ASSERT_EQ(gatherEdges(chunkedHandle.getGraph()), gatherEdges(handle.getGraph()));
+	ASSERT_GT(chunkedHandle.getConstructionTime(), 0.0);
+}
+
+TEST(ABCGeneratedGraphHandle, RejectsGraphsWithTooManyVertices) {
+	int rank, size;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+	GraphGenerators::Params params;
+	params.scale = 31;
+	GH handle(params, size, rank, {});
+	ASSERT_THROW(handle.getGraph(), std::runtime_error);
+}
@@ -0,0 +1,82 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#include <vector>
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <representations/GhostLayer.h>
+#include <representations/ArrayBackedChunkedPartition.h>
+#include <representations/AdjacencyListHashPartition.h>
+
+/*
+ * Each master stores it's numeric id, after refresh each ghost should contain numeric id of vertex it mirrors
+ */
+template <typename TGraphPartition, typename TGhostIdFn, typename TRefreshFn>
+static void checkGhostsMirrorMasters(TGraphPartition& gp, size_t ghostCount, TGhostIdFn toGhostId, TRefreshFn refresh) {
+	IMPORT_ALIASES(TGraphPartition)
+
+	int rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+	std::vector<int> state(gp.masterVerticesMaxCount() + ghostCount, -1);
+	gp.foreachMasterVertex([&](const LocalId lid) {
+		state[lid] = static_cast<int>(gp.toNumeric(lid));
+		return CONTINUE;
+	});
+
+	refresh(state.data());
+
+	size_t remoteNeighbours = 0;
+	gp.foreachMasterVertex([&](const LocalId lid) {
+		gp.foreachNeighbouringVertex(lid, [&](const GlobalId nid) {
+			if (gp.toMasterNodeId(nid) != rank) {
+				bool isGhost = false;
+				LocalId ghostId = toGhostId(nid, &isGhost);
+				EXPECT_TRUE(isGhost);
+				EXPECT_GE(ghostId, gp.masterVerticesMaxCount());
+				EXPECT_EQ(state[ghostId], static_cast<int>(gp.toNumeric(nid)));
+				remoteNeighbours += 1;
+			}
+			return CONTINUE;
+		});
+		return CONTINUE;
+	});
+
+	ASSERT_LE(ghostCount, remoteNeighbours);
+}
+
+TEST(GhostLayer, GhostsMirrorMastersABCP) {
+	int rank, size;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+	using GH = ABCGraphHandle<int, int>;
+	GH handle("resources/test/powerlaw_25_2_05_876.adjl", size, rank, {});
+	auto& gp = handle.getGraph();
+	GhostLayer<GH::GPType> ghosts(gp);
+
+	checkGhostsMirrorMasters(gp, ghosts.ghostsCount(),
+	                         [&](GH::GPType::GidType gid, bool* isGhost) {
+		                         return ghosts.toGhostId(gid.nodeId, gid.localId, isGhost);
+	                         },
+	                         [&](int* state) { ghosts.refreshGhosts(state); });
+}
+
+TEST(GhostLayer, GhostsMirrorMastersALHP) {
+	using GH = ALHGraphHandle<LocalVertexId, NumericIdRepr>;
+	ConfigMap cm;
+	cm.emplace(GH::E_DIV_OPT, "1");
+	cm.emplace(GH::V_DIV_OPT, "1");
+	cm.emplace(GH::GHOSTS_OPT, "1");
+	GBAuxiliaryParams auxParams;
+	auxParams.configMap = cm;
+
+	GH handle("resources/test/powerlaw_25_2_05_876.adjl", {}, auxParams);
+	auto& gp = handle.getGraph();
+	ASSERT_TRUE(gp.hasGhosts());
+
+	checkGhostsMirrorMasters(gp, gp.ghostVerticesCount(),
+	                         [&](GH::GPType::GidType gid, bool* isGhost) { return gp.toGhostId(gid, isGhost); },
+	                         [&](int* state) { gp.refreshGhosts(state); });
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <utils/CreditFlow.h>
+#include <utils/RequestPool.h>
+
+namespace {
+	const int TAG = 23;
+
+	struct TestMessage {
+		int value;
+		int sender;
+		int credits;
+
+		bool isCreditsOnly() const {
+			return value < 0;
+		}
+
+		void setCreditsOnly() {
+			value = -1;
+		}
+	};
+
+	/* the smallest budget, so that credits run out quickly */
+	ConfigMap smallBudget() {
+		ConfigMap cm;
+		cm.emplace(details::FlowControl::BUDGET_OPT, "0");
+		return cm;
+	}
+
+	/* receives messages that are already waiting, returns number of application ones */
+	size_t receiveAvailable(CreditFlow<TestMessage>& flow, long long& sum) {
+		size_t received = 0;
+		int flag = 1;
+		while(true) {
+			MPI_Status status;
+			MPI_Iprobe(MPI_ANY_SOURCE, TAG, MPI_COMM_WORLD, &flag, &status);
+			if (!flag) break;
+
+			TestMessage m;
+			MPI_Recv(&m, sizeof(m), MPI_BYTE, status.MPI_SOURCE, TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+			if (flow.received(m)) {
+				sum += m.value;
+				received++;
+			}
+		}
+		return received;
+	}
+
+	void assertNothingLeft() {
+		MPI_Barrier(MPI_COMM_WORLD);
+		int flag = 0;
+		MPI_Iprobe(MPI_ANY_SOURCE, TAG, MPI_COMM_WORLD, &flag, MPI_STATUS_IGNORE);
+		ASSERT_FALSE(flag);
+	}
+}
+
+TEST(CreditFlow, SendsOnlyAsManyMessagesAsThereAreCredits) {
+	int rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+	RequestPool<TestMessage> sends;
+	size_t posted = 0;
+	CreditFlow<TestMessage> flow(smallBudget(), [&](int peer, TestMessage& m) {
+		if (!m.isCreditsOnly()) posted++;
+		TestMessage *b = sends.get();
+		*b = m;
+		MPI_Request rq;
+		MPI_Isend(b, sizeof(TestMessage), MPI_BYTE, peer, TAG, MPI_COMM_WORLD, &rq);
+		sends.submit(b, rq);
+	});
+	auto perPeer = flow.creditsPerPeer();
+
+	/* messages sent to itself, so that test doesn't depend on the number of ranks */
+	const size_t count = 3*perPeer;
+	for(size_t i = 0; i < count; i++) flow.send(rank, TestMessage{1, 0, 0});
+	ASSERT_EQ(posted, perPeer);
+	ASSERT_EQ(flow.pendingCount(), count - perPeer);
+
+	size_t received = 0;
+	long long sum = 0;
+	while(received < count) {
+		received += receiveAvailable(flow, sum);
+		ASSERT_LE(posted - received, perPeer);
+		flow.flush();
+		sends.testSome();
+	}
+	ASSERT_EQ(sum, count);
+	ASSERT_EQ(flow.pendingCount(), 0);
+
+	flow.finish();
+	while(!flow.settled()) receiveAvailable(flow, sum);
+	sends.waitAll();
+	assertNothingLeft();
+}
+
+TEST(CreditFlow, DeliversAllToAllTrafficAndSettles) {
+	int rank, size;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+	RequestPool<TestMessage> sends;
+	CreditFlow<TestMessage> flow(smallBudget(), [&](int peer, TestMessage& m) {
+		TestMessage *b = sends.get();
+		*b = m;
+		MPI_Request rq;
+		MPI_Isend(b, sizeof(TestMessage), MPI_BYTE, peer, TAG, MPI_COMM_WORLD, &rq);
+		sends.submit(b, rq);
+	});
+
+	const int perPeer = 100;
+	for(int i = 1; i <= perPeer; i++) {
+		for(int peer = 0; peer < size; peer++) flow.send(peer, TestMessage{i, 0, 0});
+	}
+
+	size_t received = 0;
+	long long sum = 0;
+	while(received < static_cast<size_t>(perPeer*size) || flow.pendingCount() > 0) {
+		received += receiveAvailable(flow, sum);
+		flow.flush();
+		sends.testSome();
+	}
+	ASSERT_EQ(sum, static_cast<long long>(size)*perPeer*(perPeer + 1)/2);
+
+	flow.finish();
+	while(!flow.settled()) receiveAvailable(flow, sum);
+	sends.waitAll();
+	assertNothingLeft();
+}
@@ -0,0 +1,30 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <vector>
+#include <utils/PersistentChannel.h>
+
+TEST(PersistentChannel, ExchangesMessagesInConsecutiveRounds) {
+	int rank, size;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+	const int count = 2;
+	PersistentChannel<int> channel(MPI_INT, 5, count);
+	ASSERT_EQ(channel.getWorldSize(), size);
+
+	for(int round = 0; round < 4; round++) {
+		for(int peer = 0; peer < size; peer++) {
+			channel.sendBuffer(peer)[0] = round;
+			channel.sendBuffer(peer)[1] = rank*size + peer;
+		}
+
+		std::vector<int> receivedFrom(size, 0);
+		channel.exchange([&](int peer, int *message) {
+			receivedFrom[peer] += 1;
+			ASSERT_EQ(message[0], round);
+			ASSERT_EQ(message[1], peer*size + rank);
+		});
+
+		for(int peer = 0; peer < size; peer++) ASSERT_EQ(receivedFrom[peer], 1);
+	}
+}
@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <string>
+#include <utils/ProbeRegistry.h>
+
+TEST(ProbeRegistry, ReducesAcrossRanks) {
+	int rank, size;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+	auto& r = ProbeRegistry::instance();
+	r.reset();
+	{
+		ScopedProbe p("Algorithm");
+		r.count("edges", static_cast<unsigned long long>(rank + 1));
+		/* present only on one rank - others must still take part in the reduction */
+		if (rank == 0) r.count("only0", 7);
+	}
+
+	auto reduced = r.reduce();
+	ASSERT_EQ(reduced.ranks, size);
+
+	auto& edges = reduced.counters.at("Algorithm/edges");
+	ASSERT_DOUBLE_EQ(edges.min, 1.0);
+	ASSERT_DOUBLE_EQ(edges.max, size);
+	ASSERT_DOUBLE_EQ(edges.sum, size*(size + 1)/2.0);
+
+	auto& only0 = reduced.counters.at("Algorithm/only0");
+	ASSERT_DOUBLE_EQ(only0.max, 7.0);
+	ASSERT_DOUBLE_EQ(only0.sum, 7.0);
+
+	ASSERT_DOUBLE_EQ(reduced.timerCalls.at("Algorithm").min, 1.0);
+	ASSERT_GE(reduced.timerSeconds.at("Algorithm").max, reduced.timerSeconds.at("Algorithm").min);
+}
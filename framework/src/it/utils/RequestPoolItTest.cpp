@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <set>
+#include <utils/RequestPool.h>
+
+/* messages sent to itself, so that test doesn't depend on the number of ranks */
+
+TEST(RequestPool, RecyclesCompletedBuffers) {
+	int rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+	RequestPool<int> pool(2);
+	std::set<int*> buffers;
+	for(int i = 0; i < 4; i++) {
+		int *b = pool.get();
+		buffers.insert(b);
+		*b = i;
+		MPI_Request rq;
+		MPI_Isend(b, 1, MPI_INT, rank, i, MPI_COMM_WORLD, &rq);
+		pool.submit(b, rq);
+	}
+	ASSERT_EQ(buffers.size(), 4);
+	ASSERT_EQ(pool.inFlight(), 4);
+
+	for(int i = 0; i < 4; i++) {
+		int value;
+		MPI_Recv(&value, 1, MPI_INT, rank, i, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+		ASSERT_EQ(value, i);
+	}
+	while(pool.inFlight() > 0) pool.waitSome();
+
+	/* freed buffers are reused instead of allocating new ones */
+	for(int i = 0; i < 4; i++) ASSERT_EQ(buffers.count(pool.get()), 1);
+}
+
+TEST(RequestPool, ResubmittedBuffersStayInFlight) {
+	int rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	const int tag = 17;
+
+	RequestPool<int> receives(3);
+	for(int i = 0; i < 3; i++) {
+		int *b = receives.get();
+		MPI_Request rq;
+		MPI_Irecv(b, 1, MPI_INT, rank, tag, MPI_COMM_WORLD, &rq);
+		receives.submit(b, rq);
+	}
+
+	int sum = 0;
+	size_t received = 0;
+	auto onReceived = [&](int *b, MPI_Request &rq) {
+		sum += *b;
+		received += 1;
+		MPI_Irecv(b, 1, MPI_INT, rank, tag, MPI_COMM_WORLD, &rq);
+		return true;
+	};
+
+	for(int value = 1; value <= 5; value++) {
+		MPI_Send(&value, 1, MPI_INT, rank, tag, MPI_COMM_WORLD);
+		while(received < static_cast<size_t>(value)) receives.waitSome(onReceived);
+		ASSERT_EQ(receives.inFlight(), 3);
+	}
+	ASSERT_EQ(sum, 15);
+
+	receives.cancelAll();
+	ASSERT_EQ(receives.inFlight(), 0);
+	ASSERT_EQ(receives.testSome(), 0);
+}
@@ -0,0 +1,30 @@
+#include <gtest/gtest.h>
+#include <mpi.h>
+#include <utils/SharedArray.h>
+
+TEST(SharedArray, SegmentsOfRanksOnTheSameHostAreReadable) {
+	int rank, size;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+	const size_t count = 10;
+	SharedArray<int> array(count);
+	for(size_t i = 0; i < count; i++) array.data()[i] = rank*100 + static_cast<int>(i);
+	array.publish();
+
+	ASSERT_TRUE(array.onThisHost(rank));
+	ASSERT_EQ(array.segmentOf(rank), array.data());
+	for(int r = 0; r < size; r++) {
+		if (!array.onThisHost(r)) continue;
+		for(size_t i = 0; i < count; i++) ASSERT_EQ(array.segmentOf(r)[i], r*100 + static_cast<int>(i));
+	}
+}
+
+TEST(SharedArray, WorksForEmptySegments) {
+	int rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+	SharedArray<long long> array(rank % 2 == 0 ? 0 : 4);
+	array.publish();
+	ASSERT_NE(array.data(), nullptr);
+}
@@ -57,3 +57,29 @@ TEST(BfsValidator, RejectsIncorrectSolutionForSTG) {
 
 	ASSERT_FALSE(validationResult);
 }
+
+static bool validateWithSharedMemory(std::string solutionPath) {
+	int rank = -1;
+	int size = -1;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+	ABCGraphHandle<TestLocalId, TestNumId>  builder("resources/test/SimpleTestGraph.adjl", size, rank, {0});
+	auto& gp = builder.getGraph();
+	auto bfsRoot = builder.getConvertedVertices()[0];
+	std::pair<ABCPGid*, int*> ps = bfsSolutionAsGids<TestLocalId, ABCPGid>(solutionPath, size, rank);
+
+	BfsValidator<G> v(bfsRoot, true);
+	bool validationResult = v.validate(&gp, &ps);
+	bfsSolutionAsGidsDestroy(ps);
+
+	return validationResult;
+}
+
+TEST(BfsValidator, SharedMemoryAcceptsCorrectSolutionForSTG) {
+	ASSERT_TRUE(validateWithSharedMemory("resources/test/STG.bfssol"));
+}
+
+TEST(BfsValidator, SharedMemoryRejectsIncorrectSolutionForSTG) {
+	ASSERT_FALSE(validateWithSharedMemory("resources/test/STG_incorrect.bfssol"));
+}
@@ -9,7 +9,11 @@
 #include <utils/TestUtils.h>
 #include <Assembly.h>
 
-static void executeTest(std::string graphPath, std::string solutionPath, bool expectedValidationOutcome) {
+static void executeTest(std::string graphPath,
+                        std::string solutionPath,
+                        bool expectedValidationOutcome,
+                        ColouringValidatorMode mode = ColouringValidatorMode::RMA,
+                        bool sharedMemory = false) {
 	int rank = -1;
 	int size = -1;
 	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
@@ -20,7 +24,7 @@ static void executeTest(std::string graphPath, std::string solutionPath, bool ex
 	auto gp = builder.getGraph();
 	int *ps = loadPartialIntSolution<int>(solutionPath, size, rank);
 
-	ColouringValidator<GB::GPType> v;
+	ColouringValidator<GB::GPType> v(mode, sharedMemory);
 	bool validationResult = v.validate(&gp, ps);
 
 	ASSERT_EQ(validationResult, expectedValidationOutcome);
@@ -37,3 +41,25 @@ TEST(ColouringValidator, RejectsIncorrectSolutionForSTG) {
 TEST(ColouringValidator, AcceptsCorrectSolutionForC50) {
 	executeTest("resources/test/complete50.adjl", "resources/test/C50.csol", true);
 }
+
+TEST(ColouringValidator, BulkAcceptsCorrectSolutionForSTG) {
+	executeTest("resources/test/SimpleTestGraph.adjl", "resources/test/STG.csol", true, ColouringValidatorMode::BULK);
+}
+
+TEST(ColouringValidator, BulkRejectsIncorrectSolutionForSTG) {
+	executeTest("resources/test/SimpleTestGraph.adjl", "resources/test/STG_incorrect.csol", false,
+	            ColouringValidatorMode::BULK);
+}
+
+TEST(ColouringValidator, BulkAcceptsCorrectSolutionForC50) {
+	executeTest("resources/test/complete50.adjl", "resources/test/C50.csol", true, ColouringValidatorMode::BULK);
+}
+
+TEST(ColouringValidator, SharedMemoryAcceptsCorrectSolutionForC50) {
+	executeTest("resources/test/complete50.adjl", "resources/test/C50.csol", true, ColouringValidatorMode::RMA, true);
+}
+
+TEST(ColouringValidator, SharedMemoryRejectsIncorrectSolutionForSTG) {
+	executeTest("resources/test/SimpleTestGraph.adjl", "resources/test/STG_incorrect.csol", false,
+	            ColouringValidatorMode::RMA, true);
+}
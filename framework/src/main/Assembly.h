@@ -5,9 +5,15 @@
 #ifndef FRAMEWORK_RUNNER_H
 #define FRAMEWORK_RUNNER_H
 
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <vector>
 #include <mpi.h>
 #include <glog/logging.h>
 #include <utils/Probe.h>
+#include <utils/ProbeRegistry.h>
+#include <utils/Statistics.h>
 #include <utils/Config.h>
 #include "GraphPartition.h"
 #include "Algorithm.h"
@@ -31,6 +37,11 @@ public:
 		doRun(cmap);
 	};
 
+	/* true if assembly honours details::Assemblies::ITERATIONS_OPT & WARMUP_OPT */
+	virtual bool supportsIterations() {
+		return false;
+	}
+
 	virtual ~Assembly() {};
 
 protected:
@@ -40,11 +51,25 @@ protected:
 	Executor* parentExecutor = nullptr;
 };
 
+namespace details { namespace Assemblies {
+	const std::string SKIP_VALID_OPT = "noval";
+	/* measured iterations of the algorithm, all of them on the same graph (loaded once) */
+	const std::string ITERATIONS_OPT = "iters";
+	/* iterations run before the measured ones (e.g. to warm up caches), neither timed nor validated */
+	const std::string WARMUP_OPT = "warmup";
+	/* by default only the first measured iteration is validated */
+	const std::string VALIDATE_ALL_OPT = "val-all";
+}}
+
 /**
  *
  * This class doesn't perform any cleanup of resources that were passed it - however, you can
  * assume that as soon as run returns, they can be cleaned up
  *
+ * Graph is loaded once per run; algorithm (and validator) are obtained anew for each iteration, so subclasses must
+ * be prepared for get* being called multiple times. Time of every measured iteration is measured on rank 0 between
+ * barriers and summarized at the end.
+ *
  * @tparam TGHandle
  * @tparam TAlgorithm
  * @tparam TValidator
@@ -56,14 +81,24 @@ template <
 		>
 class AlgorithmAssembly : public Assembly {
 	using G = typename TGHandle::GPType;
-	const std::string SKIP_VALID_OPT = "noval";
 
 public:
+	/* all iterations (including warm-up ones) */
 	bool algorithmSucceeded = false;
+	/* all validated iterations */
 	bool validationSucceeded = false;
+	/* seconds, only on rank 0 */
+	std::vector<double> iterationTimes;
+
+	bool supportsIterations() override {
+		return true;
+	}
 
 	void doRun(ConfigMap config) override {
+		using namespace details::Assemblies;
+
 		LOG(INFO) << "Started executing AlgorithmAssembly";
+		currentConfig = config;
 
 		int rank, size;
 		MPI_Comm_rank(MPI_COMM_WORLD, &rank);
@@ -72,71 +107,115 @@ public:
 		bool skipValidator = false;
 		if (config.find(SKIP_VALID_OPT) != config.end())
 			skipValidator = true;
+		int iterations = 1;
+		if (config.find(ITERATIONS_OPT) != config.end()) iterations = std::stoi(config[ITERATIONS_OPT]);
+		int warmupIterations = 0;
+		if (config.find(WARMUP_OPT) != config.end()) warmupIterations = std::stoi(config[WARMUP_OPT]);
+		bool validateAll = config.find(VALIDATE_ALL_OPT) != config.end();
+		if (iterations < 1 || warmupIterations < 0)
+			throw std::runtime_error("AlgorithmAssembly: at least one measured iteration is required");
 
 		Probe graphLoadingProbe("GraphLoading");
 		Probe graphGlobalProbe("GraphLoading", true);
-		Probe algorithmExecutionProbe("Algorithm");
-		Probe algorithmGlobalProbe("Algorithm", true);
-		Probe validationProbe("Validation");
+		ProbeRegistry& registry = ProbeRegistry::instance();
+		registry.reset();
 
 		LOG(INFO) << "About to start graph loading";
 
 		MPI_Barrier(MPI_COMM_WORLD);
 		if (rank == 0) graphGlobalProbe.start();
 		graphLoadingProbe.start();
+		registry.enter("GraphLoading");
 		TGHandle& handle = getHandle();
 		auto& graph = handle.getGraph();
+		registry.leave();
 		graphLoadingProbe.stop();
 
 		LOG(INFO) << "Graph has been loaded";
 
 	    MPI_Barrier(MPI_COMM_WORLD);
-		if (rank == 0) {
-			graphGlobalProbe.stop();
-			algorithmGlobalProbe.start();
-		}
+		if (rank == 0) graphGlobalProbe.stop();
 
 		AAuxiliaryParams aaParams;
 		aaParams.config = config;
 
-		algorithmExecutionProbe.start();
-		TAlgorithm<G>& algorithm = getAlgorithm(handle);
-		algorithmSucceeded = algorithm.run(&graph, aaParams);
-		algorithmExecutionProbe.stop();
-
-		LOG(INFO) << "Algorithm has been executed";
-
-		MPI_Barrier(MPI_COMM_WORLD);
-		if (rank == 0) algorithmGlobalProbe.stop();
-
-		if (!algorithmSucceeded) {
-			LOG(ERROR) << "Error occured while executing algorithm";
-		} else {
-			LOG(INFO) << "Algorithm terminated successfully";
-		}
-
-
-		if (!skipValidator) {
-			auto solution = algorithm.getResult();
+		algorithmSucceeded = true;
+		validationSucceeded = true;
+		iterationTimes.clear();
+
+		for(int i = -warmupIterations; i < iterations; i++) {
+			bool warmup = i < 0;
+			/* warm-up iterations are recorded in separate scope, so that they don't pollute the measured ones */
+			std::string scope = warmup ? "Warmup" : "Algorithm";
+
+			Probe algorithmExecutionProbe(scope);
+			Probe algorithmGlobalProbe(scope, true);
+
+			MPI_Barrier(MPI_COMM_WORLD);
+			if (rank == 0) algorithmGlobalProbe.start();
+			algorithmExecutionProbe.start();
+			registry.enter(scope);
+			TAlgorithm<G>& algorithm = getAlgorithm(handle);
+			bool succeeded = algorithm.run(&graph, aaParams);
+			registry.leave();
+			algorithmExecutionProbe.stop();
+
+			MPI_Barrier(MPI_COMM_WORLD);
+			if (rank == 0) {
+				double seconds = std::chrono::duration<double>(algorithmGlobalProbe.stop()).count();
+				if (!warmup) iterationTimes.push_back(seconds);
+				LOG(INFO) << (warmup ? "Warm-up iteration " : "Iteration ") << (warmup ? i + warmupIterations : i)
+				          << " took " << seconds << "s";
+			}
 
-			validationProbe.start();
-			TValidator<G>& validator = getValidator(handle, algorithm);
-			validationSucceeded = validator.validate(&graph, solution);
-			validationProbe.stop();
+			algorithmSucceeded = algorithmSucceeded && succeeded;
+			if (!succeeded) {
+				LOG(ERROR) << "Error occured while executing algorithm";
+			} else {
+				LOG(INFO) << "Algorithm terminated successfully";
+			}
 
-			if(!validationSucceeded) {
-				LOG(ERROR) << "Validation failure";
+			if (warmup || (i > 0 && !validateAll)) continue;
+
+			if (!skipValidator) {
+				auto solution = algorithm.getResult();
+
+				Probe validationProbe("Validation");
+				validationProbe.start();
+				registry.enter("Validation");
+				TValidator<G>& validator = getValidator(handle, algorithm);
+				bool valid = validator.validate(&graph, solution);
+				registry.leave();
+				validationProbe.stop();
+
+				validationSucceeded = validationSucceeded && valid;
+				if(!valid) {
+					LOG(ERROR) << "Validation failure";
+				} else {
+					LOG(INFO) << "Validation success";
+				}
 			} else {
-				LOG(INFO) << "Validation success";
+				LOG(WARNING) << "Validation has been skipped";
 			}
-		} else {
-			LOG(WARNING) << "Validation has been skipped";
+		}
+
+		if (rank == 0 && iterations > 1) {
+			auto s = Statistics::summarize(iterationTimes);
+			LOG(INFO) << "Algorithm time over " << iterations << " iterations (s) | min: " << s.min << ", median: "
+			          << s.median << ", mean: " << s.mean << ", stddev: " << s.stddev << ", max: " << s.max;
 		}
 
 		handle.releaseGraph();
+
+		/* collective, so done after everything else */
+		auto jsonPathIt = config.find(details::Probes::JSON_OUTPUT_OPT);
+		registry.report(jsonPathIt != config.end() ? jsonPathIt->second : "");
 	}
 
 protected:
+	/* configuration of the run in progress, so that subclasses can parametrize algorithm/validator with it */
+	ConfigMap currentConfig;
+
 	virtual TGHandle& getHandle() = 0;
 	virtual TAlgorithm<G>& getAlgorithm(TGHandle&) = 0;
 	virtual TValidator<G>& getValidator(TGHandle&, TAlgorithm<G>&) = 0;
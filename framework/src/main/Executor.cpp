@@ -33,13 +33,22 @@ void Executor::registerAssembly(const std::string key, Assembly* assembly) {
 }
 
 bool Executor::executeAssembly(const std::string key) {
+	return executeAssembly(key, configuration);
+}
+
+bool Executor::executeAssembly(const std::string key, ConfigMap assemblyConfiguration) {
 	if (assemblies.find(key) != assemblies.end()) {
 		LOG(INFO) << "Executing assembly: " << key;
 		auto* assembly = assemblies.at(key);
-		assembly->run(configuration);
+		assembly->run(assemblyConfiguration);
 		return true;
 	} else {
 		return false;
 	}
 }
 
+
+Assembly* Executor::findAssembly(const std::string key) {
+	auto it = assemblies.find(key);
+	return it != assemblies.end() ? it->second : nullptr;
+}
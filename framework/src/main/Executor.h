@@ -28,6 +28,10 @@ public:
 	 */
 	void registerAssembly(const std::string key, Assembly* assembly);
 	bool executeAssembly(const std::string key);
+	/* runs assembly with given configuration instead of executor's one */
+	bool executeAssembly(const std::string key, ConfigMap assemblyConfiguration);
+	/* nullptr if there's no assembly registered under key */
+	Assembly* findAssembly(const std::string key);
 private:
 	std::unordered_map<std::string, Assembly*> assemblies;
 	AssemblyCleaner assemblyCleaner;
@@ -0,0 +1,83 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#ifndef FRAMEWORK_VARIANTLIST_H
+#define FRAMEWORK_VARIANTLIST_H
+
+#include <cstdint>
+#include <VariantRegistry.h>
+#include <representations/AdjacencyListHashPartition.h>
+#include <representations/ArrayBackedChunkedPartition.h>
+#include <representations/GeneratedGraphHandle.h>
+#include <representations/RoundRobin2DPartition.h>
+#include <algorithms/bfs/Bfs1CommsRound.h>
+#include <algorithms/bfs/BfsFixedMessage.h>
+#include <algorithms/bfs/BfsVarMessage.h>
+#include <algorithms/bfs/MultiSourceBfsBitset.h>
+#include <algorithms/colouring/GraphColouringMp.h>
+#include <algorithms/colouring/GraphColouringMpAsync.h>
+
+/*
+ * Single list of combinations available through VariantRegistry (registered in main.cpp), also used to instantiate
+ * all of them in TemplatesInstantiation.cpp. Handle type is the last argument, since it may contain commas.
+ */
+
+/* X(repr, ids, handle type) - graphs loaded from file */
+#define FRAMEWORK_LOADED_HANDLES(X) \
+	X("alh", "32", ALHGraphHandle<uint32_t, uint64_t>) \
+	X("alh", "64", ALHGraphHandle<uint64_t, uint64_t>) \
+	X("rr2d", "32", RR2DHandle<uint32_t, uint64_t>) \
+	X("rr2d", "64", RR2DHandle<uint64_t, uint64_t>) \
+	X("abcp", "32", ABCGraphHandle<uint32_t, uint64_t>) \
+	X("abcp", "64", ABCGraphHandle<uint64_t, uint64_t>) \
+	X("abcp", "packed", ABCGraphHandle<uint64_t, uint64_t, ABCPPackedGlobalVertexId<>>)
+
+/* X(repr, ids, handle type) - graphs generated in memory, the only ones graph500 can run on */
+#define FRAMEWORK_GENERATED_HANDLES(X) \
+	X("gen", "32", ABCGeneratedGraphHandle<uint32_t, uint64_t>) \
+	X("gen", "64", ABCGeneratedGraphHandle<uint64_t, uint64_t>) \
+	X("gen", "packed", ABCGeneratedGraphHandle<uint64_t, uint64_t, ABCPPackedGlobalVertexId<>>)
+
+/* X(variant, algorithm template) - used by bfs & graph500 */
+#define FRAMEWORK_BFS_VARIANTS(X) \
+	X("1tag", Bfs_Mp_VarMsgLen_1D_1CommsTag) \
+	X("2rounds", Bfs_Mp_VarMsgLen_1D_2CommRounds) \
+	X("fixed", Bfs_Mp_FixedMsgLen_1D_2CommRounds)
+
+#define FRAMEWORK_COLOURING_VARIANTS(X) \
+	X("mp", GraphColouringMp) \
+	X("async", GraphColouringMPAsync)
+
+#define FRAMEWORK_MSBFS_VARIANTS(X) \
+	X("bitset", MsBfs_Mp_Bitset_1D)
+
+/* how each of the representations is constructed from HandleArgs */
+template <typename TLocalId, typename TNumId>
+ALHGraphHandle<TLocalId, TNumId>* createHandle(const HandleArgs& a, ALHGraphHandle<TLocalId, TNumId>*) {
+	GBAuxiliaryParams gbAuxParams;
+	gbAuxParams.configMap = a.config;
+	return new ALHGraphHandle<TLocalId, TNumId>(a.graphPath, a.roots, gbAuxParams);
+}
+
+template <typename TLocalId, typename TNumId>
+RR2DHandle<TLocalId, TNumId>* createHandle(const HandleArgs& a, RR2DHandle<TLocalId, TNumId>*) {
+	return new RR2DHandle<TLocalId, TNumId>(a.graphPath, a.roots);
+}
+
+template <typename TLocalId, typename TNumId, typename TGlobalId>
+ABCGraphHandle<TLocalId, TNumId, TGlobalId>* createHandle(const HandleArgs& a,
+                                                          ABCGraphHandle<TLocalId, TNumId, TGlobalId>*) {
+	return new ABCGraphHandle<TLocalId, TNumId, TGlobalId>(a.graphPath, a.size, a.rank, a.roots);
+}
+
+template <typename TLocalId, typename TNumId, typename TGlobalId>
+ABCGeneratedGraphHandle<TLocalId, TNumId, TGlobalId>* createHandle(
+		const HandleArgs& a, ABCGeneratedGraphHandle<TLocalId, TNumId, TGlobalId>*) {
+	GBAuxiliaryParams gbAuxParams;
+	gbAuxParams.configMap = a.config;
+	return new ABCGeneratedGraphHandle<TLocalId, TNumId, TGlobalId>(GraphGenerators::Params::fromConfig(a.config),
+	                                                                  a.size, a.rank, a.roots, gbAuxParams);
+}
+
+#endif //FRAMEWORK_VARIANTLIST_H
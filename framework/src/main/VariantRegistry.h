@@ -0,0 +1,174 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#ifndef FRAMEWORK_VARIANTREGISTRY_H
+#define FRAMEWORK_VARIANTREGISTRY_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <utils/Config.h>
+#include <Assembly.h>
+#include <Prerequisites.h>
+
+namespace details { namespace Variants {
+	/* graph representation, e.g. alh */
+	const std::string REPRESENTATION_OPT = "repr";
+	/* width of ids, e.g. 32 */
+	const std::string IDS_OPT = "ids";
+	/* algorithm used by the assembly, e.g. bfs-1tag */
+	const std::string VARIANT_OPT = "variant";
+
+	const std::string KEY_SEPARATOR = ":";
+}}
+
+/* everything graph handles may need to be constructed */
+struct HandleArgs {
+	ConfigMap config;
+	std::string graphPath;
+	std::vector<OriginalVertexId> roots;
+	int rank = 0;
+	int size = 1;
+};
+
+/**
+ * Assembly together with graph handle it works on, both created when assembly is selected. Inner assembly is attached
+ * to the same executor when run for the first time.
+ */
+template <typename THandle>
+class OwningAssembly : public Assembly {
+public:
+	OwningAssembly(THandle* handle, Assembly* assembly) : handle(handle), assembly(assembly) {}
+
+	bool supportsIterations() override {
+		return assembly->supportsIterations();
+	}
+
+protected:
+	void doRun(ConfigMap config) override {
+		if (!attached) {
+			assembly->setExecutor(parentExecutor);
+			attached = true;
+		}
+		assembly->run(config);
+	}
+
+private:
+	/* assembly refers to the handle, so it must be destroyed first */
+	std::unique_ptr<THandle> handle;
+	std::unique_ptr<Assembly> assembly;
+	bool attached = false;
+};
+
+/**
+ * Combinations of (assembly, representation, id width, algorithm variant), all instantiated at compile time, of which
+ * only the one selected at runtime (via details::Variants options) is constructed.
+ *
+ * Options that are absent in the configuration are taken from defaults of the assembly name (which can be an alias of
+ * another assembly, e.g. gen-bfs = bfs on generated graph) and then from defaults of the representation (for id
+ * width).
+ */
+class VariantRegistry {
+public:
+	using Factory = std::function<Assembly*(const HandleArgs&)>;
+
+	template <typename THandle>
+	void add(std::string assembly, std::string representation, std::string ids, std::string variant,
+	         std::function<THandle*(const HandleArgs&)> createHandle,
+	         std::function<Assembly*(THandle&)> createAssembly) {
+		factories[key(assembly, representation, ids, variant)] = [createHandle, createAssembly](const HandleArgs& args) {
+			std::unique_ptr<THandle> handle(createHandle(args));
+			Assembly* assembly = createAssembly(*handle);
+			return new OwningAssembly<THandle>(handle.release(), assembly);
+		};
+	}
+
+	/* name under which the assembly can be selected, with its own default options */
+	void addAlias(std::string alias, std::string assembly, ConfigMap defaults = ConfigMap()) {
+		aliases[alias] = std::make_pair(assembly, defaults);
+	}
+
+	/* options used when neither configuration nor alias specifies them */
+	void setAssemblyDefaults(std::string assembly, ConfigMap defaults) {
+		assemblyDefaults[assembly] = defaults;
+	}
+
+	void setDefaultIds(std::string representation, std::string ids) {
+		defaultIds[representation] = ids;
+	}
+
+	/* assembly that would be selected for given name and configuration, with all details::Variants options filled */
+	std::pair<std::string, ConfigMap> resolveOptions(const std::string& name, const ConfigMap& config) const {
+		using namespace details::Variants;
+
+		std::string assembly = name;
+		ConfigMap merged;
+		auto alias = aliases.find(name);
+		if (alias != aliases.end()) {
+			assembly = alias->second.first;
+			merged = alias->second.second;
+		}
+		auto defaults = assemblyDefaults.find(assembly);
+		if (defaults != assemblyDefaults.end()) merged.insert(defaults->second.begin(), defaults->second.end());
+		for(auto& opt: {REPRESENTATION_OPT, IDS_OPT, VARIANT_OPT}) {
+			auto it = config.find(opt);
+			if (it != config.end()) merged[opt] = it->second;
+		}
+
+		auto representation = merged[REPRESENTATION_OPT];
+		if (merged.find(IDS_OPT) == merged.end() && defaultIds.find(representation) != defaultIds.end())
+			merged[IDS_OPT] = defaultIds.at(representation);
+
+		return std::make_pair(assembly, merged);
+	}
+
+	/* key of the combination that would be selected for given assembly name and configuration */
+	std::string resolve(const std::string& name, const ConfigMap& config) const {
+		using namespace details::Variants;
+
+		auto resolved = resolveOptions(name, config);
+		auto& options = resolved.second;
+		return key(resolved.first, options[REPRESENTATION_OPT], options[IDS_OPT], options[VARIANT_OPT]);
+	}
+
+	/* nullptr if there is no such combination */
+	Assembly* create(const std::string& name, const HandleArgs& args) const {
+		auto factory = factories.find(resolve(name, args.config));
+		if (factory == factories.end()) return nullptr;
+		return factory->second(args);
+	}
+
+	bool contains(const std::string& name, const ConfigMap& config) const {
+		return factories.find(resolve(name, config)) != factories.end();
+	}
+
+	std::vector<std::string> keys() const {
+		std::vector<std::string> ks;
+		for(auto& f: factories) ks.push_back(f.first);
+		return ks;
+	}
+
+	std::vector<std::string> aliasNames() const {
+		std::vector<std::string> names;
+		for(auto& a: aliases) names.push_back(a.first);
+		return names;
+	}
+
+	static std::string key(const std::string& assembly, const std::string& representation, const std::string& ids,
+	                       const std::string& variant) {
+		using details::Variants::KEY_SEPARATOR;
+		return assembly + KEY_SEPARATOR + representation + KEY_SEPARATOR + ids + KEY_SEPARATOR + variant;
+	}
+
+private:
+	std::map<std::string, Factory> factories;
+	std::map<std::string, std::pair<std::string, ConfigMap>> aliases;
+	std::map<std::string, ConfigMap> assemblyDefaults;
+	std::map<std::string, std::string> defaultIds;
+};
+
+#endif //FRAMEWORK_VARIANTREGISTRY_H
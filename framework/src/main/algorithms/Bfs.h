@@ -6,6 +6,7 @@
 #define FRAMEWORK_BFS_H
 
 #include <mpi.h>
+#include <string>
 #include <utility>
 #include <vector>
 #include <stddef.h>
@@ -54,11 +55,14 @@ protected:
 
 namespace details {
 	namespace fixedLen {
+		/* capacity of a single chunk - level can span any number of chunks */
 		const int MAX_VERTICES_IN_MESSAGE = 100;
 
 		template <typename TLocalId, typename TGlobalId>
 		struct VertexMessage {
 			int vidCount = 0;
+			/* sender hasn't finished the current level yet, so another round of chunks follows */
+			int moreFollows = 0;
 			TLocalId vertexIds[MAX_VERTICES_IN_MESSAGE];
 			TGlobalId predecessors[MAX_VERTICES_IN_MESSAGE];
 			GraphDist distances[MAX_VERTICES_IN_MESSAGE];
@@ -66,19 +70,20 @@ namespace details {
 			static MPI_Datatype* createVertexMessageDatatype(MPI_Datatype gidDatatype) {
 				MPI_Datatype *memory = new MPI_Datatype;
 
-				const int blocklens[] = {0, 1, MAX_VERTICES_IN_MESSAGE, MAX_VERTICES_IN_MESSAGE, MAX_VERTICES_IN_MESSAGE, 0};
+				const int blocklens[] = {0, 1, 1, MAX_VERTICES_IN_MESSAGE, MAX_VERTICES_IN_MESSAGE, MAX_VERTICES_IN_MESSAGE, 0};
 				const MPI_Aint disparray[] = {
 						0,
 						offsetof(VertexMessage, vidCount),
+						offsetof(VertexMessage, moreFollows),
 						offsetof(VertexMessage, vertexIds),
 						offsetof(VertexMessage, predecessors),
 						offsetof(VertexMessage, distances),
 						sizeof(VertexMessage),
 				};
 				auto localIdMpiType = getDatatypeFor<TLocalId>();
-				const MPI_Datatype types[] = {MPI_LB, MPI_INT, localIdMpiType, gidDatatype, GRAPH_DIST_MPI_TYPE, MPI_UB};
+				const MPI_Datatype types[] = {MPI_LB, MPI_INT, MPI_INT, localIdMpiType, gidDatatype, GRAPH_DIST_MPI_TYPE, MPI_UB};
 
-				MPI_Type_create_struct(6, blocklens, disparray, types, memory);
+				MPI_Type_create_struct(7, blocklens, disparray, types, memory);
 				MPI_Type_commit(memory);
 
 				return memory;
@@ -92,6 +97,12 @@ namespace details {
 	}
 
 	namespace varLength {
+		/* receive buffers are allocated with MPI_Alloc_mem */
+		const std::string MPI_MEMORY_OPT = "bfs-mpi-mem";
+		/* initial capacity (in vertices) of buffer for messages from a single sender, it grows when exceeded */
+		const std::string RECEIVE_CAPACITY_OPT = "bfs-recv-capacity";
+		const size_t DEFAULT_RECEIVE_CAPACITY = 1024;
+
 		template<typename TLocalId, typename TGlobalId>
 		struct VertexMessage {
 			TLocalId vertexId;
@@ -5,8 +5,11 @@
 #ifndef FRAMEWORK_COLOURING_H
 #define FRAMEWORK_COLOURING_H
 
+#include <algorithm>
 #include <cstddef>
+#include <limits>
 #include <mpi.h>
+#include <glog/logging.h>
 #include <Algorithm.h>
 #include <utils/MpiTypemap.h>
 
@@ -21,13 +24,27 @@ namespace details {
 	struct Message {
 		LocalId receiving_node_id;
 		int used_colour;
+		/* flow control, see CreditFlow */
+		int sender;
+		int credits;
+
+		bool isCreditsOnly() const {
+			return used_colour < 0;
+		}
+
+		/* doesn't concern any vertex */
+		void setCreditsOnly() {
+			used_colour = -1;
+			receiving_node_id = std::numeric_limits<LocalId>::max();
+		}
 
 		static MPI_Datatype mpiDatatype() {
 			MPI_Datatype d;
-			int blocklengths[] = {1, 1};
-			MPI_Aint displacements[] = {offsetof(Message, receiving_node_id), offsetof(Message, used_colour)};
-			MPI_Datatype building_types[] = {getDatatypeFor<LocalId>(), MPI_INT};
-			MPI_Type_create_struct(2, blocklengths, displacements, building_types, &d);
+			int blocklengths[] = {1, 1, 1, 1};
+			MPI_Aint displacements[] = {offsetof(Message, receiving_node_id), offsetof(Message, used_colour),
+			                            offsetof(Message, sender), offsetof(Message, credits)};
+			MPI_Datatype building_types[] = {getDatatypeFor<LocalId>(), MPI_INT, MPI_INT, MPI_INT};
+			MPI_Type_create_struct(4, blocklengths, displacements, building_types, &d);
 
 			return d;
 		}
@@ -44,7 +61,7 @@ namespace details {
 template <class TGraphPartition>
 class GraphColouring : public Algorithm<VertexColour*, TGraphPartition> {
 public:
-	GraphColouring() : finalColouring(nullptr) {}
+	GraphColouring() : finalColouring(nullptr), colourCount(0) {}
 
 	virtual bool run(TGraphPartition *g, AAuxiliaryParams aParams) = 0;
 	/**
@@ -61,12 +78,30 @@ public:
 		return finalColouring;
 	};
 
+	/* number of distinct colours on all nodes, known after run() */
+	VertexColour getColourCount() {
+		return colourCount;
+	}
+
 	virtual ~GraphColouring() {
 		if(finalColouring != nullptr) delete[] finalColouring;
 	};
 
 protected:
 	VertexColour* finalColouring;
+	VertexColour colourCount;
+
+	/* collective, colours are assumed to be 0..n-1 */
+	void countColours(TGraphPartition *g) {
+		VertexColour localMax = -1;
+		g->foreachMasterVertex([&](const typename TGraphPartition::LidType v) {
+			localMax = std::max(localMax, finalColouring[v]);
+			return ITER_PROGRESS::CONTINUE;
+		});
+		MPI_Allreduce(&localMax, &colourCount, 1, VERTEX_COLOUR_MPI_TYPE, MPI_MAX, MPI_COMM_WORLD);
+		colourCount += 1;
+		LOG(INFO) << "Colours used: " << colourCount;
+	}
 };
 
 #endif //FRAMEWORK_COLOURING_H
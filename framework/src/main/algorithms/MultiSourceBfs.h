@@ -0,0 +1,92 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#ifndef FRAMEWORK_MULTISOURCEBFS_H
+#define FRAMEWORK_MULTISOURCEBFS_H
+
+#include <mpi.h>
+#include <utility>
+#include <vector>
+#include <stdexcept>
+#include <climits>
+#include <stddef.h>
+
+#include <Prerequisites.h>
+#include <Algorithm.h>
+#include <utils/MpiTypemap.h>
+
+namespace details { namespace multiSource {
+	/* one bit per root, so this is also maximum number of roots traversed together */
+	using RootMask = unsigned long long;
+	const size_t MAX_ROOTS = sizeof(RootMask)*CHAR_BIT;
+
+	template <typename TLocalId, typename TGlobalId>
+	struct VertexMessage {
+		TLocalId vertexId;
+		/* roots for which sender has just been reached */
+		RootMask roots;
+		TGlobalId predecessor;
+
+		static MPI_Datatype* createMpiDatatype(MPI_Datatype gidDatatype) {
+			MPI_Datatype *memory = new MPI_Datatype;
+			MPI_Datatype unresized;
+
+			const int blocklens[] = {1, 1, 1};
+			const MPI_Aint disparray[] = {
+					offsetof(VertexMessage, vertexId),
+					offsetof(VertexMessage, roots),
+					offsetof(VertexMessage, predecessor),
+			};
+			const MPI_Datatype types[] = {getDatatypeFor<TLocalId>(), getDatatypeFor<RootMask>(), gidDatatype};
+
+			MPI_Type_create_struct(3, blocklens, disparray, types, &unresized);
+			MPI_Type_create_resized(unresized, 0, sizeof(VertexMessage), memory);
+			MPI_Type_commit(memory);
+			MPI_Type_free(&unresized);
+
+			return memory;
+		};
+
+		static void cleanupMpiDatatype(MPI_Datatype* dt) {
+			MPI_Type_free(dt);
+			delete dt;
+		}
+	};
+}}
+
+/**
+ * BFS from many roots at once (MS-BFS). Result contains separate (predecessors, distances) pair for each root,
+ * in the same order as roots were passed.
+ *
+ * Just like Bfs, 1D algorithms might not work correctly with 2D representation
+ */
+template <class TGraphPartition>
+class MultiSourceBfs
+		: public Algorithm<std::vector<std::pair<typename TGraphPartition::GidType*, GraphDist*>>*, TGraphPartition> {
+protected:
+	IMPORT_ALIASES(TGraphPartition)
+
+public:
+	MultiSourceBfs(const std::vector<GlobalId> _roots) : roots(_roots) {
+		if (roots.size() > details::multiSource::MAX_ROOTS)
+			throw std::runtime_error("Too many roots for single multi-source BFS");
+	};
+
+	virtual std::vector<std::pair<GlobalId*, GraphDist*>> *getResult() override {
+		return &result;
+	};
+
+	virtual ~MultiSourceBfs() override {
+		for(auto& p: result) {
+			if(p.first != nullptr) delete[] p.first;
+			if(p.second != nullptr) delete[] p.second;
+		}
+	};
+
+protected:
+	std::vector<std::pair<GlobalId*, GraphDist*>> result;
+	const std::vector<GlobalId> roots;
+};
+
+#endif //FRAMEWORK_MULTISOURCEBFS_H
@@ -5,7 +5,14 @@
 #ifndef FRAMEWORK_BFS1COMMSROUND_H
 #define FRAMEWORK_BFS1COMMSROUND_H
 
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
 #include <algorithms/Bfs.h>
+#include <algorithms/bfs/SharedBfsState.h>
+#include <utils/ProbeRegistry.h>
+#include <utils/SharedArray.h>
 
 template <class TGraphPartition>
 class Bfs_Mp_VarMsgLen_1D_1CommsTag : public Bfs<TGraphPartition> {
@@ -16,6 +23,9 @@ private:
 public:
 	const static int NOTHING_SENT_TAG = 1;
 	const static int SOMETHING_SENT_TAG = 2;
+	/* something sent & message didn't fit in receiver's buffer, the rest follows with OVERFLOW_TAG */
+	const static int OVERFLOW_FOLLOWS_TAG = 3;
+	const static int OVERFLOW_TAG = 4;
 
 	Bfs_Mp_VarMsgLen_1D_1CommsTag(const GlobalId _bfsRoot) : Bfs<TGraphPartition>(_bfsRoot) {};
 	~Bfs_Mp_VarMsgLen_1D_1CommsTag() {};
@@ -30,7 +40,15 @@ public:
 		this->result.first = new GlobalId[g->masterVerticesMaxCount()]();
 		this->result.second = new int[g->masterVerticesMaxCount()];
 
+		/* with shared memory, neighbours owned by ranks of this host are visited directly and messages go only to ranks
+		 * on other hosts */
+		std::unique_ptr<SharedBfsState<LocalId, GlobalId>> shared;
+		if (details::SharedMemory::enabledInConfig(aParams.config))
+			shared.reset(new SharedBfsState<LocalId, GlobalId>(g->masterVerticesMaxCount()));
+
 		std::vector<LocalVertexId> frontier;
+		/* vertices of this node visited directly during expansion */
+		std::vector<LocalVertexId> visitedDirectly;
 
 		/* append root to frontier if node matches */
 		VERTEX_TYPE rootVt;
@@ -39,111 +57,206 @@ public:
 			frontier.push_back(rootLocal);
 
 			if(rootVt == L_MASTER) {
-				/* at this point we set only distance (it'll be used in calculations for neighbours, so it must
-				 * be correct */
+				/* root is its own predecessor - this also marks it as visited, so it won't be reached again */
+				this->result.first[rootLocal] = this->bfsRoot;
 				this->result.second[rootLocal] = 0;
+				if (shared) shared->visit(currentNodeId, rootLocal, 0, this->bfsRoot);
 			}
 		}
 
 		auto sendBuffers = new std::vector<VertexM>[worldSize];
-		auto outstandingSendRequests = new MPI_Request[worldSize];
-		int completed = 0;
+		/* for each peer: request of message & of its overflow */
+		auto outstandingSendRequests = new MPI_Request[2*worldSize];
 		int* completedIndices = new int[worldSize];
 
-		VariableLengthBufferManager<VertexM> receiveBufferManager;
-		MPI_Status probeStatus;
-		int elementCountInMessage;
+		/*
+		 * one receive slot per sender, so that receives from all of them can be posted before level starts. Sender
+		 * knows capacity of its slot at the receiver and sends only that much in the first message, the rest goes in
+		 * overflow message (received into separate slot), after which both sides grow the slot in the same way
+		 */
+		bool useMpiMemory = aParams.config.find(details::varLength::MPI_MEMORY_OPT) != aParams.config.end();
+		size_t initialCapacity = details::varLength::DEFAULT_RECEIVE_CAPACITY;
+		if (aParams.config.find(details::varLength::RECEIVE_CAPACITY_OPT) != aParams.config.end())
+			initialCapacity = std::stoull(aParams.config[details::varLength::RECEIVE_CAPACITY_OPT]);
+		VariableLengthBufferManager<VertexM> receiveBufferManager(static_cast<size_t>(worldSize), useMpiMemory);
+		VariableLengthBufferManager<VertexM> overflowBufferManager(static_cast<size_t>(worldSize), useMpiMemory);
+		std::vector<size_t> receiveCapacities(worldSize, initialCapacity);
+		std::vector<size_t> peerCapacities(worldSize, initialCapacity);
+		auto receiveRequests = new MPI_Request[worldSize];
+		auto receiveStatuses = new MPI_Status[worldSize];
 
 		bool weSentAnything = false;
 		bool anyoneSentAnything = true;
+		/* distance of vertices in frontier */
+		GraphDist level = 0;
 
+		ProbeRegistry& probes = ProbeRegistry::instance();
 		while(anyoneSentAnything) {
+			ScopedProbe levelProbe("level");
 			weSentAnything = false;
 			anyoneSentAnything = false;
 
+			/* exactly one message from each node per level (possibly followed by overflow), so messages of the next
+			 * level won't be matched until all of this one have been received */
+			for(int senderId = 0; senderId < worldSize; senderId++) {
+				auto capacity = receiveCapacities[senderId];
+				VertexM *b = receiveBufferManager.getBuffer(capacity, static_cast<size_t>(senderId));
+				MPI_Irecv(b, static_cast<int>(capacity), *vertexMessage, senderId, MPI_ANY_TAG, MPI_COMM_WORLD,
+				          receiveRequests + senderId);
+			}
+
+			probes.enter("expansion");
+			unsigned long long edgesTraversed = 0;
+			unsigned long long directVisits = 0;
 			for(LocalVertexId vid: frontier) {
-				if(!g->isValid(this->getPredecessor(vid))) {
-					/* node has not yet been visited */
+				/* frontier contains only vertices visited for the first time in the previous round */
+				g->foreachNeighbouringVertex(vid, [&, vid](const GlobalId nid) {
+					weSentAnything = true;
+					edgesTraversed += 1;
+
+					auto owner = g->toMasterNodeId(nid);
+					if (shared && shared->onThisHost(owner)) {
+						directVisits += 1;
+						auto nLocal = g->toLocalId(nid);
+						if (shared->visit(owner, nLocal, level + 1, g->toGlobalId(vid)) && owner == currentNodeId)
+							visitedDirectly.push_back(nLocal);
+						return ITER_PROGRESS::CONTINUE;
+					}
 
-					g->foreachNeighbouringVertex(vid, [&sendBuffers, &weSentAnything, vid, this, g](const GlobalId nid) {
-						VertexM vInfo;
-						vInfo.vertexId = g->toLocalId(nid);
-						vInfo.predecessor = g->toGlobalId(vid);
-						vInfo.distance = this->getDistance(vid) + 1;
-						sendBuffers[g->toMasterNodeId(nid)].push_back(vInfo);
-						weSentAnything = true;
+					VertexM vInfo;
+					vInfo.vertexId = g->toLocalId(nid);
+					vInfo.predecessor = g->toGlobalId(vid);
+					vInfo.distance = shared ? level + 1 : this->getDistance(vid) + 1;
+					sendBuffers[owner].push_back(vInfo);
 
-						return ITER_PROGRESS::CONTINUE;
-					});
-				}
+					return ITER_PROGRESS::CONTINUE;
+				});
 			}
 
-			frontier.clear();
-
-			/* According to standard this should not deadlock, but better keep an eye on it */
+			frontier.swap(visitedDirectly);
+			visitedDirectly.clear();
+			probes.count("edges", edgesTraversed);
+			if (shared) probes.count("direct-visits", directVisits);
+			probes.leave();
+			probes.enter("exchange");
 
 			/* initiate send requests */
+			unsigned long long bytesSent = 0;
+			unsigned long long overflows = 0;
 			for(int i = 0; i < worldSize; i++) {
 				auto& vec = sendBuffers[i];
+				bytesSent += vec.size()*sizeof(VertexM);
+				auto capacity = peerCapacities[i];
+				bool overflow = vec.size() > capacity;
+				int tag = overflow ? OVERFLOW_FOLLOWS_TAG : (weSentAnything ? SOMETHING_SENT_TAG : NOTHING_SENT_TAG);
 				MPI_Isend(vec.data(),
-				          static_cast<int>(vec.size()),
+				          static_cast<int>(std::min(vec.size(), capacity)),
 				          *vertexMessage,
 				          i,
-				          weSentAnything ? SOMETHING_SENT_TAG : NOTHING_SENT_TAG,
+				          tag,
 				          MPI_COMM_WORLD,
 				          outstandingSendRequests + i);
+
+				outstandingSendRequests[worldSize + i] = MPI_REQUEST_NULL;
+				if (overflow) {
+					MPI_Isend(vec.data() + capacity, static_cast<int>(vec.size() - capacity), *vertexMessage, i,
+					          OVERFLOW_TAG, MPI_COMM_WORLD, outstandingSendRequests + worldSize + i);
+					peerCapacities[i] = grownCapacity(capacity, vec.size());
+					overflows += 1;
+				}
 			}
 
 			anyoneSentAnything = anyoneSentAnything || weSentAnything;
 
-			/* receive incoming messages and process data */
-			for(completed = 0; completed < worldSize; completed++) {
-				MPI_Probe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &probeStatus);
-				MPI_Get_count(&probeStatus, *vertexMessage, &elementCountInMessage);
-				anyoneSentAnything = anyoneSentAnything || (probeStatus.MPI_TAG == SOMETHING_SENT_TAG);
-				auto senderId = probeStatus.MPI_SOURCE;
-				VertexM *b = receiveBufferManager.getBuffer(static_cast<size_t>(elementCountInMessage));
-				MPI_Recv(b, elementCountInMessage, *vertexMessage, senderId, MPI_ANY_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
-
-				for(int i = 0; i < elementCountInMessage; i++) {
-					VertexM *vInfo = b + i;
-
-					/* save predecessor and distance for received node */
-					this->getDistance(vInfo->vertexId) = vInfo->distance;
-					this->getPredecessor(vInfo->vertexId) = vInfo->predecessor;
-
-					/* add it to new frontier, which'll be processed during the next iteration */
-					frontier.push_back(vInfo->vertexId);
+			/* process messages in order of completion, blocking until at least one of them arrives */
+			int processed = 0;
+			while(processed < worldSize) {
+				int completedReceives = 0;
+				MPI_Waitsome(worldSize, receiveRequests, &completedReceives, completedIndices, receiveStatuses);
+
+				for(int c = 0; c < completedReceives; c++) {
+					auto senderId = completedIndices[c];
+					auto tag = receiveStatuses[c].MPI_TAG;
+					anyoneSentAnything = anyoneSentAnything || tag == SOMETHING_SENT_TAG || tag == OVERFLOW_FOLLOWS_TAG;
+
+					int count;
+					MPI_Get_count(receiveStatuses + c, *vertexMessage, &count);
+					VertexM *b = receiveBufferManager.getCurrentBuffer(static_cast<size_t>(senderId));
+					processReceived(g, b, count, shared.get(), currentNodeId, frontier);
+
+					if (tag == OVERFLOW_FOLLOWS_TAG) {
+						MPI_Message overflowMessage;
+						MPI_Status overflowStatus;
+						MPI_Mprobe(senderId, OVERFLOW_TAG, MPI_COMM_WORLD, &overflowMessage, &overflowStatus);
+						int overflowCount;
+						MPI_Get_count(&overflowStatus, *vertexMessage, &overflowCount);
+						VertexM *ob = overflowBufferManager.getBuffer(static_cast<size_t>(overflowCount),
+						                                              static_cast<size_t>(senderId));
+						MPI_Mrecv(ob, overflowCount, *vertexMessage, &overflowMessage, MPI_STATUS_IGNORE);
+						processReceived(g, ob, overflowCount, shared.get(), currentNodeId, frontier);
+
+						auto& capacity = receiveCapacities[senderId];
+						capacity = grownCapacity(capacity, capacity + static_cast<size_t>(overflowCount));
+					}
 				}
+				processed += completedReceives;
 			}
 
-			/* wait for all send requests to finish */
-			completed = 0;
-			while(completed < worldSize) {
-				int completedInThisIt = 0;
-				MPI_Testsome(worldSize, outstandingSendRequests, &completedInThisIt, completedIndices, MPI_STATUSES_IGNORE);
-				completed += completedInThisIt;
-			}
+			MPI_Waitall(2*worldSize, outstandingSendRequests, MPI_STATUSES_IGNORE);
 
 			/* clear send buffers */
 			for(int i = 0; i < worldSize; i++) {
 				sendBuffers[i].clear();
 			}
-		}
 
-		/* set value of root node to itself (couldn't be added earlier because algorithm'd never investigate it */
-		if(rootVt == L_MASTER) {
-			this->result.first[rootLocal] = this->bfsRoot;
+			/* own vertices visited by other ranks of this host */
+			if (shared) shared->endLevel(frontier);
+			level += 1;
+
+			probes.count("messages", static_cast<unsigned long long>(worldSize) + overflows);
+			probes.count("bytes", bytesSent);
+			probes.leave();
 		}
 
+		if (shared) shared->copyResult(this->result.first, this->result.second);
+
 		/* ToDo - check if new returned memory */
 		delete[] sendBuffers;
 		delete[] outstandingSendRequests;
 		delete[] completedIndices;
+		delete[] receiveRequests;
+		delete[] receiveStatuses;
 		VertexM::cleanupMpiDatatype(vertexMessage);
 
 		return true;
 	};
+
+private:
+	/* the same on sender and receiver side, so that sender always knows how much receiver can take */
+	static size_t grownCapacity(size_t capacity, size_t required) {
+		return std::max(required, 2*capacity);
+	}
+
+	void processReceived(TGraphPartition *g, VertexM *b, int count, SharedBfsState<LocalId, GlobalId> *shared,
+	                     int currentNodeId, std::vector<LocalVertexId>& frontier) {
+		for(int i = 0; i < count; i++) {
+			VertexM *vInfo = b + i;
+			if (shared) {
+				/* ranks of this host may be visiting it at the same time */
+				if (!shared->visit(currentNodeId, vInfo->vertexId, vInfo->distance, vInfo->predecessor)) continue;
+			} else {
+				/* already visited in one of the previous rounds (or earlier in this one) */
+				if(g->isValid(this->getPredecessor(vInfo->vertexId))) continue;
+
+				/* save predecessor and distance for received node */
+				this->getDistance(vInfo->vertexId) = vInfo->distance;
+				this->getPredecessor(vInfo->vertexId) = vInfo->predecessor;
+			}
+
+			/* add it to new frontier, which'll be processed during the next iteration */
+			frontier.push_back(vInfo->vertexId);
+		}
+	}
 };
 
 
@@ -6,6 +6,7 @@
 #define FRAMEWORK_BFSFIXEDMESSAGE_H
 
 #include <algorithms/Bfs.h>
+#include <utils/PersistentChannel.h>
 
 template <class TGraphPartition>
 class Bfs_Mp_FixedMsgLen_1D_2CommRounds : public Bfs<TGraphPartition> {
@@ -39,106 +40,80 @@ public:
 			frontier.push_back(rootLocal);
 
 			if(rootVt == L_MASTER) {
-				/* at this point we set only distance (it'll be used in calculations for neighbours, so it must
-				 * be correct */
+				/* root is its own predecessor - this also marks it as visited, so it won't be reached again */
+				this->result.first[rootLocal] = this->bfsRoot;
 				this->result.second[rootLocal] = 0;
 			}
 		}
 
-		auto sendBuffers = new VertexM[worldSize];
-		auto outstandingSendRequests = new MPI_Request[worldSize];
-
-		auto receiveBuffers = new VertexM[worldSize];
-		auto outstandingReceiveRequests = new MPI_Request[worldSize];
-		/* 2 below variables used for MPI_Testsome for both sending & receiving */
-		int completed = 0;
-		// this array is not really used while sending (but something must be passed)
-		int *completedIndices = new int[worldSize];
+		/* requests to all nodes are set up once and restarted in each round */
+		auto channel = new PersistentChannel<VertexM>(*vertexMessage, SEND_TAG);
 
 		bool receivedAnything = false;
 		auto othersReceivedAnything = new bool[worldSize];
+		std::vector<LocalId> nextFrontier;
 
-		while(shouldContinue) {
-			for(LocalId vid: frontier) {
-				if(!g->isValid(this->getPredecessor(vid))) {
-					/* node has not yet been visited */
-
-					g->foreachNeighbouringVertex(vid, [&sendBuffers, vid, g, this](const GlobalId nid) {
-						auto targetNode = g->toMasterNodeId(nid);
-						VertexM *currBuffer = sendBuffers + targetNode;
-						int currentId = currBuffer->vidCount;
-
-						/* check if there is space left for yet another vertex */
-						auto maxVertCount = details::fixedLen::MAX_VERTICES_IN_MESSAGE;
-						if(currBuffer->vidCount >= maxVertCount) {
-							/* @ToDo: rather ugly, can be fixed when internal iteration is removed */
-							LOG(FATAL) << "Number of vertices in single send buffer (targetId: " << targetNode
-							           << ") larger than allowed (" << maxVertCount << ")";
-						} else {
-							/* fill the data */
-							currBuffer->vertexIds[currentId] = g->toLocalId(nid);
-							currBuffer->predecessors[currentId] = g->toGlobalId(vid);
-							currBuffer->distances[currentId] = this->getDistance(vid) + 1;
-							currBuffer->vidCount += 1;
-						}
-
-						return ITER_PROGRESS::CONTINUE;
-					});
-				}
-			}
+		/* Level is exchanged in rounds of fixed-size chunks - in each round every node sends exactly one (possibly empty)
+		 * chunk to every node, flagged if the sender hasn't finished expanding its frontier yet. Whether another round
+		 * follows depends on flags of all senders, so every node takes part in the same number of rounds. */
+		auto exchangeChunk = [&, channel, g, this](bool moreFollows) {
+			for(int i = 0; i < worldSize; i++) channel->sendBuffer(i)->moreFollows = moreFollows ? 1 : 0;
 
-			frontier.clear();
+			bool anyoneHasMore = false;
+			channel->exchange([&anyoneHasMore, &nextFrontier, g, this](int, VertexM *currentBuffer) {
+				anyoneHasMore = anyoneHasMore || (currentBuffer->moreFollows != 0);
 
-			/* initiate receive requests */
-			for(int i = 0; i < worldSize; i++) {
-				MPI_Irecv(receiveBuffers + i, 1, *vertexMessage, i, MPI_ANY_TAG, MPI_COMM_WORLD, outstandingReceiveRequests + i);
-			}
+				/* iterate over all vertices in the message */
+				for(int j = 0; j < currentBuffer->vidCount; j++) {
+					/* already visited in one of the previous rounds (or earlier in this one) */
+					if(g->isValid(this->getPredecessor(currentBuffer->vertexIds[j]))) continue;
 
-			/* initiate send requests */
-			for(int i = 0; i < worldSize; i++) {
-				MPI_Isend(sendBuffers + i, 1, *vertexMessage, i, SEND_TAG, MPI_COMM_WORLD, outstandingSendRequests + i);
-			}
-
-			/* wait for all send requests to finish */
-			completed = 0;
-			while(completed < worldSize) {
-				int completedInThisIt = 0;
-				MPI_Testsome(worldSize, outstandingSendRequests, &completedInThisIt, completedIndices, MPI_STATUSES_IGNORE);
-				completed += completedInThisIt;
-			}
+					/* save predecessor and distance for received node */
+					this->getDistance(currentBuffer->vertexIds[j]) = currentBuffer->distances[j];
+					this->getPredecessor(currentBuffer->vertexIds[j]) = currentBuffer->predecessors[j];
 
-			/* wait for all (previously started) receive requests */
-			completed = 0;
-			while(completed < worldSize) {
-				int completedInThisIt = 0;
-				MPI_Testsome(worldSize, outstandingReceiveRequests, &completedInThisIt, completedIndices, MPI_STATUSES_IGNORE);
-
-				/* iterate over all completed messages, processing received data */
-				for(int i = 0; i < completedInThisIt; i++) {
-					auto senderNodeId = completedIndices[i];
-					auto currentBuffer = receiveBuffers[senderNodeId];
-
-					/* iterate over all vertices in the message */
-					for(int j = 0; j < currentBuffer.vidCount; j++) {
-						/* save predecessor and distance for received node */
-						this->getDistance(currentBuffer.vertexIds[j]) = currentBuffer.distances[j];
-						this->getPredecessor(currentBuffer.vertexIds[j]) = currentBuffer.predecessors[j];
-
-						/* add it to new frontier, which'll be processed during the next iteration */
-						frontier.push_back(currentBuffer.vertexIds[j]);
-					}
+					/* add it to new frontier, which'll be processed during the next iteration */
+					nextFrontier.push_back(currentBuffer->vertexIds[j]);
 				}
-
-				completed += completedInThisIt;
-			}
+			});
 
 			/* clear send buffers */
 			for(int i = 0; i < worldSize; i++) {
 				/* only vidCount needs to be reset, rest could be rubbish - no compression that I'm aware of,
 				 * so skipping zeroing the rest should not be a problem */
-				sendBuffers[i].vidCount = 0;
+				channel->sendBuffer(i)->vidCount = 0;
 			}
 
+			return anyoneHasMore;
+		};
+
+		while(shouldContinue) {
+			for(LocalId vid: frontier) {
+				/* frontier contains only vertices visited for the first time in the previous round */
+				g->foreachNeighbouringVertex(vid, [channel, &exchangeChunk, vid, g, this](const GlobalId nid) {
+					auto targetNode = g->toMasterNodeId(nid);
+					VertexM *currBuffer = channel->sendBuffer(targetNode);
+
+					/* chunk is full - send it (along with others) and continue with empty one */
+					if(currBuffer->vidCount >= details::fixedLen::MAX_VERTICES_IN_MESSAGE) exchangeChunk(true);
+
+					/* fill the data */
+					int currentId = currBuffer->vidCount;
+					currBuffer->vertexIds[currentId] = g->toLocalId(nid);
+					currBuffer->predecessors[currentId] = g->toGlobalId(vid);
+					currBuffer->distances[currentId] = this->getDistance(vid) + 1;
+					currBuffer->vidCount += 1;
+
+					return ITER_PROGRESS::CONTINUE;
+				});
+			}
+
+			/* send the remaining chunks and keep receiving until all nodes finish the level */
+			while(exchangeChunk(false)) {}
+
+			frontier.swap(nextFrontier);
+			nextFrontier.clear();
+
 			/* check if we can finished - we must ensure that no-one received any new nodes to process in this round */
 			receivedAnything = frontier.size() > 0;
 			othersReceivedAnything[currentNodeId] = receivedAnything;
@@ -152,15 +127,8 @@ public:
 			}
 		}
 
-		/* set value of root node to itself (couldn't be added earlier because algorithm'd never investigate it */
-		if(rootVt == L_MASTER) {
-			this->result.first[rootLocal] = this->bfsRoot;
-		}
-
 		/* ToDo - check if new returned memory */
-		delete[] sendBuffers;
-		delete[] outstandingSendRequests;
-		delete[] completedIndices;
+		delete channel;
 		delete[] othersReceivedAnything;
 		VertexM::cleanupMpiDatatype(vertexMessage);
 
@@ -41,8 +41,8 @@ public:
 			frontier.push_back(rootLocal);
 
 			if(rootVt == L_MASTER) {
-				/* at this point we set only distance (it'll be used in calculations for neighbours, so it must
-				 * be correct */
+				/* root is its own predecessor - this also marks it as visited, so it won't be reached again */
+				this->result.first[rootLocal] = this->bfsRoot;
 				this->result.second[rootLocal] = 0;
 			}
 		}
@@ -61,19 +61,16 @@ public:
 
 		while(shouldContinue) {
 			for(LocalVertexId vid: frontier) {
-				if(!g->isValid(this->getPredecessor(vid))) {
-					/* node has not yet been visited */
-
-					g->foreachNeighbouringVertex(vid, [&sendBuffers, vid, this, g](const GlobalId nid) {
-						VertexM vInfo;
-						vInfo.vertexId = g->toLocalId(nid);
-						vInfo.predecessor = g->toGlobalId(vid);
-						vInfo.distance = this->getDistance(vid) + 1;
-						sendBuffers[g->toMasterNodeId(nid)].push_back(vInfo);
-
-						return CONTINUE;
-					});
-				}
+				/* frontier contains only vertices visited for the first time in the previous round */
+				g->foreachNeighbouringVertex(vid, [&sendBuffers, vid, this, g](const GlobalId nid) {
+					VertexM vInfo;
+					vInfo.vertexId = g->toLocalId(nid);
+					vInfo.predecessor = g->toGlobalId(vid);
+					vInfo.distance = this->getDistance(vid) + 1;
+					sendBuffers[g->toMasterNodeId(nid)].push_back(vInfo);
+
+					return CONTINUE;
+				});
 			}
 
 			frontier.clear();
@@ -103,6 +100,9 @@ public:
 				for(int i = 0; i < elementCountInMessage; i++) {
 					auto *vInfo = b + i;
 
+					/* already visited in one of the previous rounds (or earlier in this one) */
+					if(g->isValid(this->getPredecessor(vInfo->vertexId))) continue;
+
 					/* save predecessor and distance for received node */
 					this->getDistance(vInfo->vertexId) = vInfo->distance;
 					this->getPredecessor(vInfo->vertexId) = vInfo->predecessor;
@@ -138,11 +138,6 @@ public:
 			}
 		}
 
-		/* set value of root node to itself (couldn't be added earlier because algorithm'd never investigate it */
-		if(rootVt == L_MASTER) {
-			this->result.first[rootLocal] = this->bfsRoot;
-		}
-
 		/* ToDo - check if new returned memory */
 		delete[] sendBuffers;
 		delete[] outstandingSendRequests;
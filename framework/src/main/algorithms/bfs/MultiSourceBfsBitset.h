@@ -0,0 +1,159 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#ifndef FRAMEWORK_MULTISOURCEBFSBITSET_H
+#define FRAMEWORK_MULTISOURCEBFSBITSET_H
+
+#include <glog/logging.h>
+#include <algorithms/MultiSourceBfs.h>
+#include <utils/ProbeRegistry.h>
+
+/**
+ * Level-synchronous MS-BFS. Each vertex keeps bitsets (one bit per root) of roots that already reached it (visited),
+ * that reached it in current level (frontier) and in the next one. Vertex in the frontier sends a single message
+ * to each neighbour, carrying whole frontier bitset - so one level exchange serves all roots.
+ *
+ * Level exchange is done with alltoallv, termination is detected with allreduce.
+ */
+template <class TGraphPartition>
+class MsBfs_Mp_Bitset_1D : public MultiSourceBfs<TGraphPartition> {
+private:
+	IMPORT_ALIASES(TGraphPartition)
+	using RootMask = details::multiSource::RootMask;
+	using VertexM = details::multiSource::VertexMessage<LocalId, GlobalId>;
+
+public:
+	MsBfs_Mp_Bitset_1D(const std::vector<GlobalId> _roots) : MultiSourceBfs<TGraphPartition>(_roots) {};
+
+	bool run(TGraphPartition *g, AAuxiliaryParams) {
+		int currentNodeId;
+		MPI_Comm_rank(MPI_COMM_WORLD, &currentNodeId);
+		int worldSize;
+		MPI_Comm_size(MPI_COMM_WORLD, &worldSize);
+
+		MPI_Datatype* vertexMessage = VertexM::createMpiDatatype(g->getGlobalVertexIdDatatype());
+
+		const auto maxCount = g->masterVerticesMaxCount();
+		const auto rootCount = this->roots.size();
+		for(size_t r = 0; r < rootCount; r++) {
+			this->result.push_back(std::make_pair(new GlobalId[maxCount](), new GraphDist[maxCount]()));
+		}
+
+		std::vector<RootMask> visited(maxCount, 0);
+		std::vector<RootMask> frontierMask(maxCount, 0);
+		std::vector<RootMask> nextMask(maxCount, 0);
+		std::vector<LocalId> frontier;
+		std::vector<LocalId> nextFrontier;
+
+		/* roots are their own predecessors */
+		for(size_t r = 0; r < rootCount; r++) {
+			auto root = this->roots[r];
+			VERTEX_TYPE rootVt;
+			auto rootLocal = g->toLocalId(root, &rootVt);
+			if(rootVt == L_MASTER) {
+				RootMask bit = RootMask(1) << r;
+				if(frontierMask[rootLocal] == 0) frontier.push_back(rootLocal);
+				frontierMask[rootLocal] |= bit;
+				visited[rootLocal] |= bit;
+				this->result[r].first[rootLocal] = root;
+				this->result[r].second[rootLocal] = 0;
+			}
+		}
+
+		auto sendBuffers = new std::vector<VertexM>[worldSize];
+		std::vector<VertexM> sendFlat;
+		std::vector<VertexM> received;
+		std::vector<int> sendCounts(worldSize), sendDispls(worldSize), recvCounts(worldSize), recvDispls(worldSize);
+
+		GraphDist level = 0;
+		bool anyoneHasFrontier = true;
+		ProbeRegistry& probes = ProbeRegistry::instance();
+		while(anyoneHasFrontier) {
+			ScopedProbe levelProbe("level");
+
+			/* expand frontier - one message per edge, regardless of number of roots it carries */
+			probes.enter("expansion");
+			unsigned long long edgesTraversed = 0;
+			for(LocalId vid: frontier) {
+				RootMask mask = frontierMask[vid];
+				frontierMask[vid] = 0;
+				GlobalId vGid = g->toGlobalId(vid);
+
+				g->foreachNeighbouringVertex(vid, [&](const GlobalId nid) {
+					VertexM m;
+					m.vertexId = g->toLocalId(nid);
+					m.roots = mask;
+					m.predecessor = vGid;
+					sendBuffers[g->toMasterNodeId(nid)].push_back(m);
+					edgesTraversed += 1;
+					return ITER_PROGRESS::CONTINUE;
+				});
+			}
+			frontier.clear();
+			probes.count("edges", edgesTraversed);
+			probes.leave();
+
+			/* exchange */
+			probes.enter("exchange");
+			int sendTotal = 0;
+			for(int i = 0; i < worldSize; i++) {
+				sendCounts[i] = static_cast<int>(sendBuffers[i].size());
+				sendDispls[i] = sendTotal;
+				sendTotal += sendCounts[i];
+			}
+			sendFlat.resize(sendTotal);
+			for(int i = 0; i < worldSize; i++) {
+				std::copy(sendBuffers[i].begin(), sendBuffers[i].end(), sendFlat.begin() + sendDispls[i]);
+				sendBuffers[i].clear();
+			}
+
+			MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+			int recvTotal = 0;
+			for(int i = 0; i < worldSize; i++) {
+				recvDispls[i] = recvTotal;
+				recvTotal += recvCounts[i];
+			}
+			received.resize(recvTotal);
+			MPI_Alltoallv(sendFlat.data(), sendCounts.data(), sendDispls.data(), *vertexMessage,
+			              received.data(), recvCounts.data(), recvDispls.data(), *vertexMessage, MPI_COMM_WORLD);
+			probes.count("messages", static_cast<unsigned long long>(worldSize));
+			probes.count("bytes", static_cast<unsigned long long>(sendTotal)*sizeof(VertexM));
+			probes.leave();
+
+			/* process - only roots that haven't reached vertex yet are of interest */
+			for(auto& m: received) {
+				RootMask fresh = m.roots & ~visited[m.vertexId];
+				if(fresh == 0) continue;
+
+				visited[m.vertexId] |= fresh;
+				if(nextMask[m.vertexId] == 0) nextFrontier.push_back(m.vertexId);
+				nextMask[m.vertexId] |= fresh;
+
+				while(fresh != 0) {
+					auto r = __builtin_ctzll(fresh);
+					fresh &= fresh - 1;
+					this->result[r].first[m.vertexId] = m.predecessor;
+					this->result[r].second[m.vertexId] = level + 1;
+				}
+			}
+
+			std::swap(frontier, nextFrontier);
+			std::swap(frontierMask, nextMask);
+			level += 1;
+
+			ScopedProbe terminationProbe("termination");
+			bool weHaveFrontier = !frontier.empty();
+			MPI_Allreduce(&weHaveFrontier, &anyoneHasFrontier, 1, MPI_CXX_BOOL, MPI_LOR, MPI_COMM_WORLD);
+		}
+
+		LOG(INFO) << "Multi-source BFS (" << rootCount << " roots) finished after " << level << " levels";
+
+		delete[] sendBuffers;
+		VertexM::cleanupMpiDatatype(vertexMessage);
+
+		return true;
+	};
+};
+
+#endif //FRAMEWORK_MULTISOURCEBFSBITSET_H
@@ -0,0 +1,111 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#ifndef FRAMEWORK_SHAREDBFSSTATE_H
+#define FRAMEWORK_SHAREDBFSSTATE_H
+
+#include <cstddef>
+#include <vector>
+#include <mpi.h>
+#include <Prerequisites.h>
+#include <utils/NonCopyable.h>
+#include <utils/SharedArray.h>
+
+/**
+ * Distances & predecessors of master vertices of all ranks of this host, kept in shared memory (see SharedArray), so
+ * that vertex owned by any of them can be visited with an atomic update instead of a message.
+ *
+ * Vertex is claimed by compare-and-swap on its distance, the winner writes its predecessor. Vertices claimed for
+ * another rank are appended to that rank's queue, which it drains into its frontier in endLevel(). There are two queues
+ * per rank used in alternate levels, since ranks which have already left endLevel() may fill the next one before the
+ * owner drains the current one.
+ *
+ * Construction, endLevel() and destruction are collective operations.
+ */
+template <typename TLocalId, typename TGlobalId>
+class SharedBfsState : NonCopyable {
+public:
+	static const GraphDist UNVISITED = -1;
+
+	SharedBfsState(size_t maxVerticesCount) : maxVerticesCount(maxVerticesCount), vertices(maxVerticesCount),
+	                                          queues(QUEUES_OFFSET + 2*maxVerticesCount) {
+		MPI_Comm_rank(MPI_COMM_WORLD, &nodeId);
+
+		for(size_t v = 0; v < maxVerticesCount; v++) vertices.data()[v].distance = UNVISITED;
+		queues.data()[0] = 0;
+		queues.data()[1] = 0;
+		vertices.publish();
+		queues.publish();
+	}
+
+	bool onThisHost(int owner) const {
+		return vertices.onThisHost(owner);
+	}
+
+	/*
+	 * owner must run on this host; true if vertex hasn't been visited before. If it has been claimed for this rank,
+	 * caller is responsible for putting it in the frontier
+	 */
+	bool visit(int owner, TLocalId v, GraphDist distance, TGlobalId predecessor) {
+		VertexState& s = vertices.segmentOf(owner)[v];
+		GraphDist expected = UNVISITED;
+		if (!__atomic_compare_exchange_n(&s.distance, &expected, distance, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+			return false;
+		s.predecessor = predecessor;
+
+		if (owner != nodeId) {
+			TLocalId* q = queues.segmentOf(owner);
+			auto position = __atomic_fetch_add(q + parity, 1, __ATOMIC_RELAXED);
+			q[QUEUES_OFFSET + parity*maxVerticesCount + position] = v;
+		}
+		return true;
+	}
+
+	/* distance of own vertex */
+	GraphDist getDistance(TLocalId v) {
+		return vertices.data()[v].distance;
+	}
+
+	/* makes all visits of this level visible & appends own vertices visited by other ranks to frontier */
+	template <typename TFrontierId>
+	void endLevel(std::vector<TFrontierId>& frontier) {
+		vertices.publish();
+		queues.publish();
+
+		TLocalId* q = queues.data();
+		TLocalId* queued = q + QUEUES_OFFSET + parity*maxVerticesCount;
+		frontier.insert(frontier.end(), queued, queued + q[parity]);
+		/* other ranks use it again only after the next endLevel(), which makes this visible to them */
+		q[parity] = 0;
+		parity = 1 - parity;
+	}
+
+	/* copies state of own visited vertices to result arrays */
+	void copyResult(TGlobalId* predecessors, GraphDist* distances) {
+		VertexState* own = vertices.data();
+		for(size_t v = 0; v < maxVerticesCount; v++) {
+			if (own[v].distance == UNVISITED) continue;
+			distances[v] = own[v].distance;
+			predecessors[v] = own[v].predecessor;
+		}
+	}
+
+private:
+	struct VertexState {
+		GraphDist distance;
+		TGlobalId predecessor;
+	};
+
+	/* queue segment: sizes of both queues, followed by their contents */
+	static const size_t QUEUES_OFFSET = 2;
+
+	int nodeId;
+	size_t maxVerticesCount;
+	SharedArray<VertexState> vertices;
+	SharedArray<TLocalId> queues;
+	/* queue used in current level */
+	int parity = 0;
+};
+
+#endif //FRAMEWORK_SHAREDBFSSTATE_H
@@ -0,0 +1,232 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#ifndef FRAMEWORK_COLOURINGPRIORITIES_H
+#define FRAMEWORK_COLOURINGPRIORITIES_H
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <mpi.h>
+#include <glog/logging.h>
+#include <GraphPartition.h>
+#include <representations/GhostLayer.h>
+#include <utils/Config.h>
+#include <utils/NonCopyable.h>
+
+namespace details { namespace ColouringPriority {
+	/*
+	 * id     - numeric id (default)
+	 * degree - largest degree first, ties broken by hashed id
+	 * random - hashed id (Jones-Plassmann)
+	 * sl     - smallest-last, approximated by peeling vertices of small degree in rounds
+	 */
+	const std::string PRIORITY_OPT = "col-priority";
+	const std::string SEED_OPT = "col-seed";
+
+	/* splitmix64 finalizer */
+	inline uint64_t hash(uint64_t x, uint64_t seed) {
+		x += seed + 0x9e3779b97f4a7c15ULL;
+		x = (x ^ (x >> 30))*0xbf58476d1ce4e5b9ULL;
+		x = (x ^ (x >> 27))*0x94d049bb133111ebULL;
+		return x ^ (x >> 31);
+	}
+
+	/* primary key in high half, hash as a tie-breaker in low one */
+	inline uint64_t withHash(uint64_t primary, uint64_t hashed) {
+		return (primary << 32) | (hashed & 0xffffffffULL);
+	}
+}}
+
+/**
+ * Order in which neighbouring vertices choose colours - vertex with the higher priority chooses first and the other
+ * waits for it. Priorities are total: equal keys are ordered by numeric id.
+ *
+ * Keys of id & random can be computed for any vertex locally. Keys of degree & sl depend on the neighbourhood,
+ * so they're computed by owners and copied to ghosts of remote neighbours (see GhostLayer) - construction is
+ * collective (MPI_COMM_WORLD) then.
+ */
+template <class TGraphPartition>
+class ColouringPriorities : NonCopyable {
+	IMPORT_ALIASES(TGraphPartition)
+
+public:
+	enum Kind {ID, DEGREE, RANDOM, SMALLEST_LAST};
+
+	ColouringPriorities(TGraphPartition& g, ConfigMap config) : g(g), kind(parseKind(config)), seed(0) {
+		using namespace details::ColouringPriority;
+
+		MPI_Comm_rank(MPI_COMM_WORLD, &nodeId);
+		if (config.find(SEED_OPT) != config.end()) seed = std::stoull(config[SEED_OPT]);
+		if (kind == ID || kind == RANDOM) return;
+
+		ghosts.reset(new GhostLayer<TGraphPartition>(g));
+		keys.assign(g.masterVerticesMaxCount() + ghosts->ghostsCount(), 0);
+		if (kind == DEGREE) {
+			g.foreachMasterVertex([&](const LocalId v) {
+				keys[v] = withHash(degree(v), hash(g.toNumeric(v), seed));
+				return ITER_PROGRESS::CONTINUE;
+			});
+		} else {
+			smallestLast();
+		}
+		ghosts->refreshGhosts(keys.data());
+	}
+
+	/* true if (local or remote) neighbour chooses colour before master v */
+	bool precedes(const GlobalId neighbour, const LocalId v) {
+		return key(neighbour) > key(v);
+	}
+
+	/* true if master v chooses colour before its (local or remote) neighbour */
+	bool follows(const GlobalId neighbour, const LocalId v) {
+		return key(neighbour) < key(v);
+	}
+
+	Kind getKind() {
+		return kind;
+	}
+
+private:
+	using Key = std::pair<uint64_t, NumericId>;
+
+	TGraphPartition& g;
+	Kind kind;
+	uint64_t seed;
+	NodeId nodeId;
+	std::unique_ptr<GhostLayer<TGraphPartition>> ghosts;
+	/* masters, then ghosts */
+	std::vector<uint64_t> keys;
+
+	static Kind parseKind(ConfigMap& config) {
+		using details::ColouringPriority::PRIORITY_OPT;
+
+		if (config.find(PRIORITY_OPT) == config.end()) return ID;
+		auto name = config[PRIORITY_OPT];
+		if (name == "id") return ID;
+		if (name == "degree") return DEGREE;
+		if (name == "random") return RANDOM;
+		if (name == "sl") return SMALLEST_LAST;
+		throw std::runtime_error("Unknown colouring priority: " + name);
+	}
+
+	Key key(const LocalId v) {
+		auto num = g.toNumeric(v);
+		switch(kind) {
+			case ID: return Key(0, num);
+			case RANDOM: return Key(details::ColouringPriority::hash(num, seed), num);
+			default: return Key(keys[v], num);
+		}
+	}
+
+	Key key(const GlobalId gid) {
+		auto num = g.toNumeric(gid);
+		switch(kind) {
+			case ID: return Key(0, num);
+			case RANDOM: return Key(details::ColouringPriority::hash(num, seed), num);
+			default: return Key(keys[slot(gid)], num);
+		}
+	}
+
+	/* index of vertex in keys - own masters directly, remote ones through their ghosts */
+	LocalId slot(const GlobalId gid) {
+		auto owner = g.toMasterNodeId(gid);
+		if (owner == nodeId) return g.toLocalId(gid);
+		return ghosts->toGhostId(owner, g.toLocalId(gid));
+	}
+
+	uint64_t degree(const LocalId v) {
+		uint64_t d = 0;
+		g.foreachNeighbouringVertex(v, [&d](const GlobalId) {
+			d++;
+			return ITER_PROGRESS::CONTINUE;
+		});
+		return d;
+	}
+
+	/**
+	 * In each round vertices whose degree (in the graph of not yet removed ones) is at most 2*min+1 are removed, min
+	 * being the smallest degree on all nodes. Vertices removed later choose colours first. Removals of remote neighbours
+	 * are learned from ghosts, refreshed once per round.
+	 */
+	void smallestLast() {
+		using namespace details::ColouringPriority;
+		const uint64_t NOT_REMOVED = std::numeric_limits<uint64_t>::max();
+
+		auto firstGhost = ghosts->firstGhostId();
+		std::vector<uint64_t> currentDegree(g.masterVerticesMaxCount(), 0);
+		std::vector<uint64_t> removedIn(keys.size(), NOT_REMOVED);
+
+		/* masters neighbouring each ghost, in CSR form, so that its removal can be applied in O(its degree) */
+		std::vector<size_t> ghostOffsets(ghosts->ghostsCount() + 1, 0);
+		g.foreachMasterVertex([&](const LocalId v) {
+			currentDegree[v] = degree(v);
+			g.foreachNeighbouringVertex(v, [&](const GlobalId n) {
+				if (g.toMasterNodeId(n) != nodeId) ghostOffsets[slot(n) - firstGhost + 1]++;
+				return ITER_PROGRESS::CONTINUE;
+			});
+			return ITER_PROGRESS::CONTINUE;
+		});
+		for(size_t i = 1; i < ghostOffsets.size(); i++) ghostOffsets[i] += ghostOffsets[i - 1];
+		std::vector<LocalId> ghostNeighbours(ghostOffsets.back());
+		std::vector<size_t> fill(ghostOffsets.begin(), ghostOffsets.end() - 1);
+		g.foreachMasterVertex([&](const LocalId v) {
+			g.foreachNeighbouringVertex(v, [&](const GlobalId n) {
+				if (g.toMasterNodeId(n) != nodeId) ghostNeighbours[fill[slot(n) - firstGhost]++] = v;
+				return ITER_PROGRESS::CONTINUE;
+			});
+			return ITER_PROGRESS::CONTINUE;
+		});
+
+		auto decrement = [&](const LocalId v) {
+			if (removedIn[v] == NOT_REMOVED) currentDegree[v]--;
+		};
+
+		uint64_t round = 0;
+		std::vector<LocalId> removedNow;
+		while(true) {
+			uint64_t localMin = NOT_REMOVED, globalMin = NOT_REMOVED;
+			g.foreachMasterVertex([&](const LocalId v) {
+				if (removedIn[v] == NOT_REMOVED && currentDegree[v] < localMin) localMin = currentDegree[v];
+				return ITER_PROGRESS::CONTINUE;
+			});
+			MPI_Allreduce(&localMin, &globalMin, 1, MPI_UINT64_T, MPI_MIN, MPI_COMM_WORLD);
+			if (globalMin == NOT_REMOVED) break;
+
+			auto threshold = 2*globalMin + 1;
+			removedNow.clear();
+			g.foreachMasterVertex([&](const LocalId v) {
+				if (removedIn[v] == NOT_REMOVED && currentDegree[v] <= threshold) removedNow.push_back(v);
+				return ITER_PROGRESS::CONTINUE;
+			});
+			for(auto v: removedNow) removedIn[v] = round;
+			for(auto v: removedNow) {
+				g.foreachNeighbouringVertex(v, [&](const GlobalId n) {
+					if (g.toMasterNodeId(n) == nodeId) decrement(g.toLocalId(n));
+					return ITER_PROGRESS::CONTINUE;
+				});
+			}
+
+			ghosts->refreshGhosts(removedIn.data());
+			for(size_t i = 0; i < ghosts->ghostsCount(); i++) {
+				if (removedIn[firstGhost + i] != round) continue;
+				for(auto j = ghostOffsets[i]; j < ghostOffsets[i + 1]; j++) decrement(ghostNeighbours[j]);
+			}
+
+			round++;
+		}
+
+		g.foreachMasterVertex([&](const LocalId v) {
+			keys[v] = withHash(removedIn[v], hash(g.toNumeric(v), seed));
+			return ITER_PROGRESS::CONTINUE;
+		});
+		LOG(INFO) << "Smallest-last ordering computed in " << round << " rounds";
+	}
+};
+
+#endif //FRAMEWORK_COLOURINGPRIORITIES_H
@@ -0,0 +1,73 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#ifndef FRAMEWORK_COLOURINGSTATE_H
+#define FRAMEWORK_COLOURINGSTATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <algorithms/Colouring.h>
+
+/**
+ * Per-vertex state of greedy colouring in dense arrays indexed by local id: number of neighbours the vertex still
+ * waits for and colours already used by its neighbours.
+ *
+ * Used colours are a bitmask - the first 64 colours inline, the rest spilled to per-vertex words allocated only for
+ * vertices that see such colours (greedy colouring never needs more than max degree + 1 colours, so spilling is rare).
+ * The smallest free colour is the number of trailing ones of the mask.
+ */
+class ColouringState {
+	static const int WORD_BITS = 64;
+
+public:
+	/* -1 marks vertices that have already been coloured */
+	static const long long COLOURED = -1;
+
+	ColouringState(size_t vertexCount) : waitCounters(vertexCount, 0), usedColours(vertexCount, 0) {}
+
+	long long& waitCounter(size_t v) {
+		return waitCounters[v];
+	}
+
+	void markUsed(size_t v, VertexColour colour) {
+		auto c = static_cast<size_t>(colour);
+		if (c < WORD_BITS) {
+			usedColours[v] |= bit(c);
+		} else {
+			auto& words = spilled[v];
+			auto w = c/WORD_BITS - 1;
+			if (words.size() <= w) words.resize(w + 1, 0);
+			words[w] |= bit(c % WORD_BITS);
+		}
+	}
+
+	/* smallest colour not used by any neighbour */
+	VertexColour firstFree(size_t v) const {
+		if (~usedColours[v] != 0) return __builtin_ctzll(~usedColours[v]);
+
+		auto it = spilled.find(v);
+		size_t w = 0;
+		if (it != spilled.end()) {
+			for(; w < it->second.size(); w++) {
+				auto free = ~it->second[w];
+				if (free != 0) return static_cast<VertexColour>((w + 1)*WORD_BITS + __builtin_ctzll(free));
+			}
+		}
+		return static_cast<VertexColour>((w + 1)*WORD_BITS);
+	}
+
+private:
+	std::vector<long long> waitCounters;
+	std::vector<uint64_t> usedColours;
+	/* words of colours 64..127, 128..191, ... */
+	std::unordered_map<size_t, std::vector<uint64_t>> spilled;
+
+	static uint64_t bit(size_t i) {
+		return static_cast<uint64_t>(1) << i;
+	}
+};
+
+#endif //FRAMEWORK_COLOURINGSTATE_H
@@ -9,31 +9,28 @@
 #include <cstring>
 #include <cstddef>
 #include <functional>
-#include <set>
-#include <list>
-#include <unordered_map>
 #include <sstream>
+#include <vector>
 #include <mpi.h>
 #include <glog/logging.h>
 #include <algorithms/Colouring.h>
-#include <utils/BufferPool.h>
+#include <algorithms/colouring/ColouringPriorities.h>
+#include <algorithms/colouring/ColouringState.h>
+#include <utils/CreditFlow.h>
+#include <utils/ProbeRegistry.h>
+#include <utils/RequestPool.h>
 
 namespace details { namespace GraphColouringMp {
-	/* values in mB */
-	const std::string IN_REQ_SOFT_OPT = "gcm-in-rs";
-	const std::string IN_REQ_HARD_OPT = "gcm-in-rh";
+	/* value in mB; number of sends in flight is bounded by CreditFlow (see its options) */
 	const std::string OUT_REQ_OPT = "gcm-out";
 
 	struct Config {
-		/* counts, not mB */
-		size_t inRequestsSoft = 1000;
-		size_t inRequestsHard = 2000;
+		/* count, not mB */
 		size_t outRequests = 1000;
 
 		std::string to_string() {
 			std::stringstream ss;
-			ss << "GraphColouringMp | inSoft: " << inRequestsSoft << ", inHard: " << inRequestsHard
-			   << ", out: " << outRequests;
+			ss << "GraphColouringMp | out: " << outRequests;
 			return ss.str();
 		}
 	};
@@ -48,10 +45,6 @@ namespace details { namespace GraphColouringMp {
 	Config buildConfig(ConfigMap cm, size_t v_count) {
 		Config c;
 
-		if (cm.find(IN_REQ_SOFT_OPT) != cm.end())
-			c.inRequestsSoft = mbToCount<TLocalId>(std::stoull(cm[IN_REQ_SOFT_OPT]));
-		if (cm.find(IN_REQ_HARD_OPT) != cm.end())
-			c.inRequestsHard = mbToCount<TLocalId>(std::stoull(cm[IN_REQ_HARD_OPT]));
 		if (cm.find(OUT_REQ_OPT) != cm.end()) {
 			auto v = cm[OUT_REQ_OPT];
 			size_t ombs = 0;
@@ -66,20 +59,8 @@ namespace details { namespace GraphColouringMp {
 
 		return c;
 	}
-
-	template<typename TLocalId>
-	struct BufferAndRequest {
-		MPI_Request request;
-		Message<TLocalId> buffer;
-	};
 }}
 
-/*
- * todo:
- * * swap with last (maybe don't use separate list for free buffers?
- * * keep limit of free buffers! (decide what to do in iterate?
- */
-
 template <class TGraphPartition>
 class GraphColouringMp : public GraphColouring<TGraphPartition> {
 private:
@@ -102,76 +83,50 @@ public:
 		int nodeId;
 		MPI_Comm_rank(MPI_COMM_WORLD, &nodeId);
 
-		std::unordered_map<LocalId, VertexTempData*> vertexDataMap;
+		ColouringPriorities<TGraphPartition> priorities(*g, aParams.config);
+		ColouringState state(g->masterVerticesMaxCount());
 		this->finalColouring = new VertexColour[g->masterVerticesMaxCount()];
 
 		MPI_Datatype mpi_message_type = Message<LocalId>::mpiDatatype();
 		MPI_Type_commit(&mpi_message_type);
 
-		BufferPool<BufferAndRequest<LocalId>> receiveBuffers(parsedConf.outRequests);
-
-		size_t receivesFinished = 0;
-		auto tryFreeReceiveCb = [&vertexDataMap, &mpi_message_type, &receivesFinished](BufferAndRequest<LocalId> *b) {
-			int receive_result = 0;
-			MPI_Test(&b->request, &receive_result, MPI_STATUS_IGNORE);
-
-			if (receive_result != 0) {
-				/* completed */
-				MPI_Wait(&b->request, MPI_STATUS_IGNORE);
-				int t_id = b->buffer.receiving_node_id;
-				vertexDataMap[t_id]->wait_counter -= 1;
-				vertexDataMap[t_id]->used_colours.insert(b->buffer.used_colour);
-				VLOG(V_LOG_LVL) << "Received: node = " << b->buffer.receiving_node_id << ", colour = "
-				                << b->buffer.used_colour;
-
-				/* post new request */
-				MPI_Irecv(&b->buffer, 1, mpi_message_type, MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &b->request);
-				receivesFinished += 1;
-			}
-
-			/* one way or another, buffer doesn't change it's status */
-			return false;
-		};
+		RequestPool<Message<LocalId>> receives(parsedConf.outRequests);
+		RequestPool<Message<LocalId>> sends;
+		CreditFlow<Message<LocalId>> flow(aParams.config, [&sends, &mpi_message_type](int peer, Message<LocalId>& m) {
+			Message<LocalId> *b = sends.get();
+			*b = m;
 
+			MPI_Request rq;
+			MPI_Isend(b, 1, mpi_message_type, peer, MPI_TAG, MPI_COMM_WORLD, &rq);
+			sends.submit(b, rq);
+		});
+		LOG(INFO) << "Credits per peer: " << flow.creditsPerPeer();
 
+		/* vertices whose all neighbours with higher priorities have chosen colours, so they can choose one too */
+		std::vector<LocalId> ready;
 
-		auto mpiWaitIfFinished = [](BufferAndRequest<LocalId> *b) {
-			int result = 0;
-			MPI_Test(&b->request, &result, MPI_STATUS_IGNORE);
-			if (result != 0) {
-				MPI_Wait(&b->request, MPI_STATUS_IGNORE);
-				return true;
-			} else {
-				return false;
+		auto onReceived = [&state, &ready, &flow, &mpi_message_type](Message<LocalId> *b, MPI_Request &rq) {
+			if (flow.received(*b)) {
+				auto t_id = b->receiving_node_id;
+				if (--state.waitCounter(t_id) == 0) ready.push_back(t_id);
+				state.markUsed(t_id, b->used_colour);
+				VLOG(V_LOG_LVL) << "Received: node = " << b->receiving_node_id << ", colour = " << b->used_colour;
 			}
-		};
 
-		auto mpiHardWaitCb = [](BufferAndRequest<LocalId> *b) {
-			MPI_Wait(&b->request, MPI_STATUS_IGNORE);
-		};
-
-		#ifdef GCM_NO_LOCAL_SHORTCIRCUIT
-		auto oneOffHardCb = [&receivesFinished, &tryFreeReceiveCb, &receiveBuffers]() {
-			receivesFinished = 0;
-			receiveBuffers.foreachUsed(tryFreeReceiveCb);
-			VLOG(V_LOG_LVL-2) << "Emergency hard wait, flushed " << receivesFinished << " receive operations";
-		};
-		#else
-		auto oneOffHardCb = []() {
-			VLOG(V_LOG_LVL-2) << "Emergency hard wait, no flushing";
+			/* post new request */
+			MPI_Irecv(b, 1, mpi_message_type, MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &rq);
+			return true;
 		};
-		#endif
-
-		AutoFreeingBuffer<BufferAndRequest<LocalId>> sendBuffers(parsedConf.inRequestsSoft, parsedConf.inRequestsHard,
-		                                                         mpiWaitIfFinished, mpiHardWaitCb, oneOffHardCb);
 
 		LOG(INFO) << "Finished initialization";
 
 		/* start outstanding receive requests */
-		receiveBuffers.foreachFree([&](BufferAndRequest<LocalId> *b) {
-			MPI_Irecv(&b->buffer, 1, mpi_message_type, MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &b->request);
-			return true;
-		});
+		for(size_t i = 0; i < parsedConf.outRequests; i++) {
+			auto *b = receives.get();
+			MPI_Request rq;
+			MPI_Irecv(b, 1, mpi_message_type, MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &rq);
+			receives.submit(b, rq);
+		}
 
 		LOG(INFO) << "Posted initial outstanding receive requests";
 
@@ -179,14 +134,12 @@ public:
 		g->foreachMasterVertex([&](const LocalId v_id) {
 			auto v_id_num = g->toNumeric(v_id);
 
-			vertexDataMap[v_id] = new VertexTempData();
-
 			VLOG(V_LOG_LVL) << "Looking @ " << g->idToString(v_id) << "(" << v_id_num << ") neighbours";
 			g->foreachNeighbouringVertex(v_id, [&](const GlobalId neigh_id) {
 				auto neigh_num = g->toNumeric(neigh_id);
 				VLOG(V_LOG_LVL) << "Looking @ " << g->idToString(neigh_id) << "(" << neigh_num << ")";
-				if (neigh_num > v_id_num) {
-					vertexDataMap[v_id]->wait_counter++;
+				if (priorities.precedes(neigh_id, v_id)) {
+					state.waitCounter(v_id)++;
 					VLOG(V_LOG_LVL+1) << "Qualified!";
 				} else {
 					VLOG(V_LOG_LVL+1) << "Rejected!";
@@ -195,129 +148,109 @@ public:
 				return ITER_PROGRESS::CONTINUE;
 			});
 
-			VLOG(V_LOG_LVL) << "Waiting for " << vertexDataMap[v_id]->wait_counter << " vertices to establish colouring";
+			VLOG(V_LOG_LVL) << "Waiting for " << state.waitCounter(v_id) << " vertices to establish colouring";
+			if (state.waitCounter(v_id) == 0) ready.push_back(v_id);
 
 			return ITER_PROGRESS::CONTINUE;
 		});
 
 		LOG(INFO) << "Finished gathering information about neighbours";
 
-		int coloured_count = 0;
+		size_t coloured_count = 0;
+		size_t rounds = 0;
 		size_t all_count = g->masterVerticesCount();
-		while(coloured_count < all_count) {
-			/* process vertices with count == 0 */
+		/* messages of last vertices may still wait for credits */
+		while(coloured_count < all_count || flow.pendingCount() > 0) {
+			rounds++;
+			/* process vertices with count == 0 (including ones that reach it while processing others) */
 			size_t coloured_this_iter = 0;
-			size_t still_waiting = 0;
-			g->foreachMasterVertex([&, nodeId, this](const LocalId v_id) {
-				auto wc = vertexDataMap[v_id]->wait_counter;
-				VLOG(V_LOG_LVL+1) << g->idToString(v_id) << " current wait_counter: " << wc;
-
-				assert(wc >= -1);
-
-				if(wc == 0) {
-					auto v_id_num = g->toNumeric(v_id);
-
-					/* lets find smallest unused colour */
-					int iter_count = 0;
-					int previous_used_colour = -1;
-					/* find first gap */
-					for(auto used_colour: vertexDataMap[v_id]->used_colours) {
-						if (iter_count < used_colour) break; /* we found gap */
-						previous_used_colour = used_colour;
-						iter_count += 1;
-					}
-					int chosen_colour = previous_used_colour + 1;
-					this->finalColouring[v_id] = chosen_colour;
-
-					VLOG(V_LOG_LVL) << "!!! All neighbours of " << g->idToString(v_id) << "(" << v_id_num
-					                << ") chosen colours, we choose " << chosen_colour;
-
-					/* inform neighbours */
-					g->foreachNeighbouringVertex(v_id, [&, g, nodeId](const GlobalId neigh_id) {
-						NumericId neigh_num = g->toNumeric(neigh_id);
-						if (neigh_num < v_id_num) {
-							/* if it's larger it already has colour and is not interested */
-							auto neighNodeId = g->toMasterNodeId(neigh_id);
-							auto neighLocalId = g->toLocalId(neigh_id);
-							#ifndef GCM_NO_LOCAL_SHORTCIRCUIT
-							if(neighNodeId == nodeId) {
-								vertexDataMap[neighLocalId]->wait_counter -= 1;
-								vertexDataMap[neighLocalId]->used_colours.insert(chosen_colour);
-								VLOG(V_LOG_LVL+1) << g->idToString(neigh_id) << "(" << neigh_num
-								          << ") is local, informing about colour "<< chosen_colour;
-							} else {
-							#endif
-								BufferAndRequest<LocalId> *b = sendBuffers.get();
-								b->buffer.receiving_node_id = neighLocalId;
-								b->buffer.used_colour = chosen_colour;
-
-								MPI_Isend(&b->buffer, 1, mpi_message_type, neighNodeId, MPI_TAG, MPI_COMM_WORLD, &b->request);
-
-								VLOG(V_LOG_LVL+1) << "Isend to " << g->idToString(neigh_id) << "(" << neigh_num << ") info that "
-								          << g->idToString(v_id) << "(" << v_id_num << ") has been coloured with "
-								          << chosen_colour;
-							#ifndef GCM_NO_LOCAL_SHORTCIRCUIT
-							}
-							#endif
+			while(!ready.empty()) {
+				LocalId v_id = ready.back();
+				ready.pop_back();
+				assert(state.waitCounter(v_id) == 0);
+
+				auto v_id_num = g->toNumeric(v_id);
+
+				/* lets find smallest unused colour */
+				VertexColour chosen_colour = state.firstFree(v_id);
+				this->finalColouring[v_id] = chosen_colour;
+
+				VLOG(V_LOG_LVL) << "!!! All neighbours of " << g->idToString(v_id) << "(" << v_id_num
+				                << ") chosen colours, we choose " << chosen_colour;
+
+				/* inform neighbours */
+				g->foreachNeighbouringVertex(v_id, [&, g, nodeId](const GlobalId neigh_id) {
+					NumericId neigh_num = g->toNumeric(neigh_id);
+					if (priorities.follows(neigh_id, v_id)) {
+						/* if it precedes v_id it already has colour and is not interested */
+						auto neighNodeId = g->toMasterNodeId(neigh_id);
+						auto neighLocalId = g->toLocalId(neigh_id);
+						#ifndef GCM_NO_LOCAL_SHORTCIRCUIT
+						if(neighNodeId == nodeId) {
+							if (--state.waitCounter(neighLocalId) == 0) ready.push_back(neighLocalId);
+							state.markUsed(neighLocalId, chosen_colour);
+							VLOG(V_LOG_LVL+1) << g->idToString(neigh_id) << "(" << neigh_num
+							          << ") is local, informing about colour "<< chosen_colour;
+						} else {
+						#endif
+							Message<LocalId> m;
+							m.receiving_node_id = neighLocalId;
+							m.used_colour = chosen_colour;
+							flow.send(neighNodeId, m);
+
+							VLOG(V_LOG_LVL+1) << "Sending to " << g->idToString(neigh_id) << "(" << neigh_num << ") info that "
+							          << g->idToString(v_id) << "(" << v_id_num << ") has been coloured with "
+							          << chosen_colour;
+						#ifndef GCM_NO_LOCAL_SHORTCIRCUIT
 						}
-
-						return ITER_PROGRESS::CONTINUE;
-					});
-					VLOG(V_LOG_LVL+1) << "Informed neighbours about colour being chosen";
-
-					vertexDataMap[v_id]->wait_counter = -1; // so that we don't process it over and over again
-					coloured_this_iter += 1;
-					coloured_count += 1;
+						#endif
+					}
 
 					return ITER_PROGRESS::CONTINUE;
-				} else if (wc != -1) {
-					still_waiting += 1;
-				}
+				});
+				VLOG(V_LOG_LVL+1) << "Informed neighbours about colour being chosen";
 
-				sendBuffers.tryFree();
-
-				return ITER_PROGRESS::CONTINUE;
-			});
+				state.waitCounter(v_id) = ColouringState::COLOURED;
+				coloured_this_iter += 1;
+				coloured_count += 1;
+			}
 
 			VLOG(V_LOG_LVL-1) << "0-wait processing finished. Coloured " << coloured_this_iter << ". On this node "
-			                  << coloured_count << "/" << all_count << ". Still waiting for: " << still_waiting;
+			                  << coloured_count << "/" << all_count << ". Still waiting for: " << all_count - coloured_count;
 
 			/* check if any outstanding receive request completed */
-			receivesFinished = parsedConf.outRequests; // just to enter 0 iteration of a looop
+			size_t receivesFinished = parsedConf.outRequests; // just to enter 0 iteration of a looop
 			uint32_t cycleCount = 0;
 			while(receivesFinished == parsedConf.outRequests) {
-				receivesFinished = 0;
-				receiveBuffers.foreachUsed(tryFreeReceiveCb);
+				receivesFinished = receives.testSome(onReceived);
 				cycleCount += 1;
 			}
 			VLOG(V_LOG_LVL-2) << receivesFinished << '/' << parsedConf.outRequests << " (" << cycleCount
 			                  << " cycles) receives succesfully waited on";
 
-			/* wait for send requests and clean them up */
-			sendBuffers.wait();
+			/* post messages for which credits came back, clean up completed sends */
+			flow.flush();
+			sends.testSome();
 			VLOG(V_LOG_LVL) << "Finished (for current iteration) waiting for send buffers";
 		}
 
 		/* clean up */
 
-		/* for some reason MPI_Cancel hangs sometimes, usually when compiling with GCM_NO_LOCAL_SHORTCIRCUIT enabled
-		 * since no proper cleanup is carried out, running multiple repetitions wihtin single process is probably
-		 * not a good idea
-		 */
-		#ifndef GCM_NO_LOCAL_SHORTCIRCUIT
-		receiveBuffers.foreachUsed([&](BufferAndRequest<LocalId> *b) {
-			MPI_Cancel(&b->request);
-			return true;
-		});
-		#endif
+		/* every colour sent to this node has already been received (vertices wait for all their messages), only
+		 * credits may be still on their way - after they arrive outstanding receives can't match anything from this run,
+		 * so cancel them and wait for cancellation to complete, so that they can't steal messages of the next run */
+		flow.finish();
+		while(!flow.settled()) receives.testSome(onReceived);
+		receives.cancelAll();
+		sends.waitAll();
 
 		MPI_Type_free(&mpi_message_type);
-
-		for(auto kv: vertexDataMap) {
-			delete kv.second;
-		}
 		LOG(INFO) << "Cleanup finished, terminating";
 
+		LOG(INFO) << "Colouring took " << rounds << " rounds";
+		ProbeRegistry::instance().count("rounds", rounds);
+		this->countColours(g);
+
 		return true;
 	}
 };
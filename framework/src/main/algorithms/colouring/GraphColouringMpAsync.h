@@ -16,8 +16,10 @@
 #include <boost/pool/object_pool.hpp>
 #include <glog/logging.h>
 #include <algorithms/Colouring.h>
+#include <algorithms/colouring/ColouringPriorities.h>
 #include <utils/MPIAsync.h>
 #include <utils/CliColours.h>
+#include <utils/CreditFlow.h>
 
 namespace details { namespace ColouringMpAsync {
 	static const int V_LOG_LVL = 5;
@@ -43,8 +45,10 @@ namespace details { namespace ColouringMpAsync {
 		NodeId nodeId;
 		MPI_Datatype *mpi_message_type;
 		TGraphPartition *g;
+		ColouringPriorities<TGraphPartition> *priorities;
+		CreditFlow<Message<LocalId>> *flow;
 		// @todo make it size_t
-		int *coloured_count;
+		size_t *coloured_count;
 		MPIAsync *am;
 
 		boost::object_pool<Message<LocalId>> *sendPool;
@@ -103,8 +107,8 @@ namespace details { namespace ColouringMpAsync {
 			/* inform neighbours */
 			gd->g->foreachNeighbouringVertex(v_id, [&](const GlobalId neigh_id) {
 				auto neigh_num = gd->g->toNumeric(neigh_id);
-				if (neigh_num < v_id_num) {
-					/* if it's larger it already has colour and is not interested */
+				if (gd->priorities->follows(neigh_id, v_id)) {
+					/* if it precedes v_id it already has colour and is not interested */
 					auto neighNodeId = gd->g->toMasterNodeId(neigh_id);
 					auto neighLocalId = gd->g->toLocalId(neigh_id);
 					if(neighNodeId == gd->nodeId) {
@@ -120,19 +124,14 @@ namespace details { namespace ColouringMpAsync {
 							VLOG(V_LOG_LVL+2) << "Scheduled";
 						}
 					} else {
-						Message<LocalId> *b = gd->sendPool->construct();
-						b->receiving_node_id = neighLocalId;
-						b->used_colour = chosen_colour;
+						Message<LocalId> m;
+						m.receiving_node_id = neighLocalId;
+						m.used_colour = chosen_colour;
+						gd->flow->send(neighNodeId, m);
 
-						MPI_Request *rq = reinterpret_cast<MPI_Request *>(gd->mpiRequestPool->malloc());
-						MPI_Isend(b, 1, *gd->mpi_message_type, neighNodeId, MPI_TAG, MPI_COMM_WORLD, rq);
-
-						VLOG(V_LOG_LVL+1) << "Isend to " << gd->g->idToString(neigh_id) << "(" << neigh_num << ") info that "
+						VLOG(V_LOG_LVL+1) << "Sending to " << gd->g->idToString(neigh_id) << "(" << neigh_num << ") info that "
 						          << gd->g->idToString(v_id) << "(" << v_id_num << ") has been coloured with "
 						          << chosen_colour << " scheduled";
-
-						OnSendFinished<TGraphPartition> *cb = gd->sendFinishedCbPool->construct(b, gd);
-						gd->am->submitWaitingTask(rq, cb);
 					}
 				}
 
@@ -155,6 +154,13 @@ namespace details { namespace ColouringMpAsync {
 		OnReceiveFinished(Message<LocalId> *buffer, GlobalData<TGraphPartition> *globalData) : b(buffer), gd(globalData) {}
 
 		virtual void operator()() override {
+			if (!gd->flow->received(*b)) {
+				MPI_Request *rq = scheduleReceive(b, gd->mpi_message_type, gd->mpiRequestPool);
+				gd->am->submitWaitingTask(rq, gd->receiveFinishedCbPool->construct(b, gd));
+				gd->receiveFinishedCbPool->destroy(this);
+				return;
+			}
+
 			auto t_id = b->receiving_node_id;
 			VLOG(V_LOG_LVL) << "Received: node = " << t_id << ", colour = " << b->used_colour;
 
@@ -213,16 +219,29 @@ public:
 		boost::object_pool<ColourVertex<TGraphPartition>> colourVertexCbPool;
 		boost::pool<> requestPool(sizeof(MPI_Request));
 
+		ColouringPriorities<TGraphPartition> priorities(*g, aParams.config);
+
 		RequestCleaner *rc = new RequestCleaner(requestPool);
 		MPIAsync am(rc);
-		int coloured_count = 0;
+		size_t coloured_count = 0;
 
 		LOG(INFO) << "Finished initialization";
 
 		GlobalData<TGraphPartition> globalData;
+		CreditFlow<Message<LocalId>> flow(aParams.config, [&](int peer, Message<LocalId>& m) {
+			Message<LocalId> *b = sendPool.construct(m);
+
+			MPI_Request *rq = reinterpret_cast<MPI_Request *>(requestPool.malloc());
+			MPI_Isend(b, 1, mpi_message_type, peer, MPI_TAG, MPI_COMM_WORLD, rq);
+			am.submitWaitingTask(rq, sendFinishedCbPool.construct(b, &globalData));
+		});
+		LOG(INFO) << "Credits per peer: " << flow.creditsPerPeer();
+
 		globalData.am = &am;
 		globalData.coloured_count = &coloured_count;
 		globalData.g = g;
+		globalData.priorities = &priorities;
+		globalData.flow = &flow;
 		globalData.mpi_message_type = &mpi_message_type;
 		globalData.nodeId = nodeId;
 		globalData.vertexDataMap = &vertexDataMap;
@@ -253,7 +272,7 @@ public:
 			g->foreachNeighbouringVertex(v_id, [&](const GlobalId neigh_id) {
 				auto neigh_num = g->toNumeric(neigh_id);
 				VLOG(V_LOG_LVL+1) << "N: " << g->idToString(neigh_id) << "(" << neigh_num << ")";
-				if (neigh_num > v_id_num) {
+				if (priorities.precedes(neigh_id, v_id)) {
 					wait_counter++;
 					VLOG(V_LOG_LVL+1) << "Qualified!";
 				} else {
@@ -275,13 +294,17 @@ public:
 
 		LOG(INFO) << "Finished gathering information about neighbours";
 
-		while(coloured_count < g->masterVerticesCount()) {
+		/* messages of last vertices may still wait for credits */
+		while(coloured_count < g->masterVerticesCount() || flow.pendingCount() > 0) {
 			/* check if any outstanding receive request completed */
 			am.pollAll();
+			flow.flush();
 			VLOG(V_LOG_LVL) << "Finished current iteration of task queue processing";
 		}
 
 		/* clean up */
+		flow.finish();
+		while(!flow.settled()) am.pollAll();
 		am.shutdown();
 
 		MPI_Type_free(&mpi_message_type);
@@ -291,6 +314,8 @@ public:
 		}
 		LOG(INFO) << "Cleanup finished, terminating";
 
+		this->countColours(g);
+
 		return true;
 	}
 };
@@ -28,13 +28,15 @@ protected:
 
 	virtual TBfs<G>& getAlgorithm(TGHandle&) override {
 		auto bfsRoot = h.getConvertedVertices()[0];
+		if (bfs != nullptr) {delete bfs;}
 		bfs = new TBfs<G>(bfsRoot);
 		return *bfs;
 	};
 
 	virtual BfsValidator<G>& getValidator(TGHandle&, TBfs<G>&) override {
 		auto bfsRoot = h.getConvertedVertices()[0];
-		validator = new BfsValidator<G>(bfsRoot);
+		if (validator != nullptr) {delete validator;}
+		validator = new BfsValidator<G>(bfsRoot, details::SharedMemory::enabledInConfig(this->currentConfig));
 		return *validator;
 	};
 
@@ -27,12 +27,15 @@ protected:
 	};
 
 	virtual TColouring<G>& getAlgorithm(TGHandle&) override {
+		if (algo != nullptr) {delete algo;}
 		algo = new TColouring<G>();
 		return *algo;
 	};
 
 	virtual ColouringValidator<G>& getValidator(TGHandle&, TColouring<G>&) override {
-		validator = new ColouringValidator<G>();
+		auto mode = details::ColouringValidator::modeFromConfig(this->currentConfig);
+		if (validator != nullptr) {delete validator;}
+		validator = new ColouringValidator<G>(mode, details::SharedMemory::enabledInConfig(this->currentConfig));
 		return *validator;
 	};
 
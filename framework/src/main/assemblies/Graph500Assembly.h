@@ -0,0 +1,187 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#ifndef FRAMEWORK_GRAPH500ASSEMBLY_H
+#define FRAMEWORK_GRAPH500ASSEMBLY_H
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <mpi.h>
+#include <glog/logging.h>
+#include <Assembly.h>
+#include <utils/Probe.h>
+#include <utils/ProbeRegistry.h>
+#include <utils/RootSampling.h>
+#include <utils/Statistics.h>
+#include <validators/BfsValidator.h>
+
+namespace details { namespace Graph500 {
+	const std::string ROOTS_COUNT_OPT = "g500-roots";
+	const std::string ROOTS_SEED_OPT = "g500-seed";
+	const std::string SKIP_VALID_OPT = "noval";
+	const size_t DEFAULT_ROOTS_COUNT = 64;
+}}
+
+/**
+ * Graph500 benchmark: BFS from (by default) 64 randomly chosen non-isolated roots of the generated graph, each one
+ * validated with BfsValidator. Timings come from global probes (measured on rank 0, between barriers); rank 0 prints
+ * the summary in Graph500 output format.
+ *
+ * TEPS are computed from number of (undirected, deduplicated) edges in the traversed component.
+ *
+ * TGHandle must expose generator parameters and generation & construction times (see ABCGeneratedGraphHandle).
+ */
+template <template <typename> class TBfs, typename TGHandle>
+class Graph500Assembly : public Assembly {
+	using G = typename TGHandle::GPType;
+	IMPORT_ALIASES(G)
+
+public:
+	Graph500Assembly(TGHandle& graphHandle) : h(graphHandle) {}
+
+	bool allValid = false;
+
+protected:
+	void doRun(ConfigMap config) override {
+		using namespace details::Graph500;
+
+		int rank, size;
+		MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+		MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+		size_t rootsCount = DEFAULT_ROOTS_COUNT;
+		if (config.find(ROOTS_COUNT_OPT) != config.end()) rootsCount = std::stoul(config[ROOTS_COUNT_OPT]);
+		unsigned long long rootsSeed = h.getGeneratorParams().seed;
+		if (config.find(ROOTS_SEED_OPT) != config.end()) rootsSeed = std::stoull(config[ROOTS_SEED_OPT]);
+		bool skipValidation = config.find(SKIP_VALID_OPT) != config.end();
+
+		ProbeRegistry& registry = ProbeRegistry::instance();
+		registry.reset();
+
+		registry.enter("G500Construction");
+		G& g = h.getGraph();
+		registry.leave();
+		/* the slowest node determines both */
+		double localTimes[] = {h.getGenerationTime(), h.getConstructionTime()};
+		double times[2];
+		MPI_Allreduce(localTimes, times, 2, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+		auto roots = RootSampling::nonIsolated(g, rootsCount, rootsSeed);
+		LOG(INFO) << "Running Graph500 BFS for " << roots.size() << " roots";
+
+		AAuxiliaryParams aaParams;
+		aaParams.config = config;
+
+		std::vector<double> bfsTimes, validationTimes, edgeCounts, teps;
+		allValid = true;
+		for(auto& root: roots) {
+			auto* bfs = new TBfs<G>(root);
+
+			MPI_Barrier(MPI_COMM_WORLD);
+			Probe bfsProbe("G500Bfs", true);
+			if (rank == 0) bfsProbe.start();
+			registry.enter("G500Bfs");
+			bool succeeded = bfs->run(&g, aaParams);
+			registry.leave();
+			MPI_Barrier(MPI_COMM_WORLD);
+			double bfsTime = 0.0;
+			if (rank == 0) bfsTime = toSeconds(bfsProbe.stop());
+
+			double traversedEdges = static_cast<double>(countTraversedEdges(g, bfs->getResult()));
+
+			bool valid = succeeded;
+			if (!skipValidation) {
+				Probe validationProbe("G500Validation", true);
+				if (rank == 0) validationProbe.start();
+				registry.enter("G500Validation");
+				BfsValidator<G> validator(root, details::SharedMemory::enabledInConfig(config));
+				valid = validator.validate(&g, bfs->getResult()) && valid;
+				registry.leave();
+				if (rank == 0) validationTimes.push_back(toSeconds(validationProbe.stop()));
+			}
+
+			if (!valid) LOG(ERROR) << "Graph500 BFS failed for root " << g.idToString(root);
+			allValid = allValid && valid;
+
+			if (rank == 0) {
+				bfsTimes.push_back(bfsTime);
+				edgeCounts.push_back(traversedEdges);
+				teps.push_back(traversedEdges/bfsTime);
+			}
+
+			delete bfs;
+		}
+
+		if (rank == 0) {
+			printReport(size, roots.size(), times[0], times[1], bfsTimes, edgeCounts, teps, validationTimes);
+		}
+
+		h.releaseGraph();
+
+		auto jsonPathIt = config.find(details::Probes::JSON_OUTPUT_OPT);
+		registry.report(jsonPathIt != config.end() ? jsonPathIt->second : "");
+	}
+
+private:
+	TGHandle& h;
+
+	static double toSeconds(std::chrono::nanoseconds ns) {
+		return std::chrono::duration_cast<std::chrono::duration<double>>(ns).count();
+	}
+
+	/* number of undirected edges with both ends reached (each is seen from both of its ends) */
+	unsigned long long countTraversedEdges(G& g, std::pair<GlobalId*, GraphDist*>* result) {
+		unsigned long long localDegreeSum = 0;
+		g.foreachMasterVertex([&](const LocalId vid) {
+			if (g.isValid(result->first[vid])) {
+				g.foreachNeighbouringVertex(vid, [&](const GlobalId) {
+					localDegreeSum += 1;
+					return ITER_PROGRESS::CONTINUE;
+				});
+			}
+			return ITER_PROGRESS::CONTINUE;
+		});
+
+		unsigned long long degreeSum = 0;
+		MPI_Allreduce(&localDegreeSum, &degreeSum, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+		return degreeSum/2;
+	}
+
+	void printReport(int processCount, size_t nbfs, double generationTime, double constructionTime,
+	                 std::vector<double>& bfsTimes, std::vector<double>& edgeCounts, std::vector<double>& teps,
+	                 std::vector<double>& validationTimes) {
+		auto& params = h.getGeneratorParams();
+		std::ostream& os = std::cout;
+
+		os << "SCALE: " << params.scale << "\n"
+		   << "edgefactor: " << params.edgeFactor << "\n"
+		   << "NBFS: " << nbfs << "\n"
+		   << "graph_generation: " << generationTime << "\n"
+		   << "num_mpi_processes: " << processCount << "\n"
+		   << "construction_time: " << constructionTime << "\n";
+
+		printStatistics(os, "time", Statistics::summarize(bfsTimes), false);
+		printStatistics(os, "nedge", Statistics::summarize(edgeCounts), false);
+		printStatistics(os, "TEPS", Statistics::summarizeHarmonic(teps), true);
+		if (!validationTimes.empty())
+			printStatistics(os, "validate", Statistics::summarize(validationTimes), false);
+
+		os << std::flush;
+	}
+
+	static void printStatistics(std::ostream& os, std::string name, SummaryStatistics s, bool harmonic) {
+		std::string meanPrefix = harmonic ? "harmonic_" : "";
+		os << "bfs  min_" << name << ": " << s.min << "\n"
+		   << "bfs  firstquartile_" << name << ": " << s.firstQuartile << "\n"
+		   << "bfs  median_" << name << ": " << s.median << "\n"
+		   << "bfs  thirdquartile_" << name << ": " << s.thirdQuartile << "\n"
+		   << "bfs  max_" << name << ": " << s.max << "\n"
+		   << "bfs  " << meanPrefix << "mean_" << name << ": " << s.mean << "\n"
+		   << "bfs  " << meanPrefix << "stddev_" << name << ": " << s.stddev << "\n";
+	}
+};
+
+#endif //FRAMEWORK_GRAPH500ASSEMBLY_H
@@ -0,0 +1,61 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#ifndef FRAMEWORK_MULTISOURCEBFSASSEMBLY_H
+#define FRAMEWORK_MULTISOURCEBFSASSEMBLY_H
+
+#include <Assembly.h>
+#include <algorithms/MultiSourceBfs.h>
+#include <validators/MultiSourceBfsValidator.h>
+
+/**
+ * Uses all vertices converted by the handle as roots (at most details::multiSource::MAX_ROOTS of them)
+ */
+template <template <typename> class TMsBfs, typename TGHandle>
+class MultiSourceBfsAssembly : public AlgorithmAssembly<TGHandle, TMsBfs, MultiSourceBfsValidator> {
+	using G = typename TGHandle::GPType;
+	using GlobalId = typename G::GidType;
+
+public:
+	MultiSourceBfsAssembly(TGHandle& graphHandle) : h(graphHandle), bfs(nullptr), validator(nullptr) {}
+
+	~MultiSourceBfsAssembly() {
+		if (bfs != nullptr) {delete bfs;}
+		if (validator != nullptr) {delete validator;}
+	}
+
+protected:
+	virtual TGHandle& getHandle() override {
+		return h;
+	};
+
+	virtual TMsBfs<G>& getAlgorithm(TGHandle&) override {
+		if (bfs != nullptr) {delete bfs;}
+		bfs = new TMsBfs<G>(getRoots());
+		return *bfs;
+	};
+
+	virtual MultiSourceBfsValidator<G>& getValidator(TGHandle&, TMsBfs<G>&) override {
+		if (validator != nullptr) {delete validator;}
+		validator = new MultiSourceBfsValidator<G>(getRoots(), details::SharedMemory::enabledInConfig(this->currentConfig));
+		return *validator;
+	};
+
+private:
+	TGHandle& h;
+	TMsBfs<G> *bfs;
+	MultiSourceBfsValidator<G> *validator;
+
+	std::vector<GlobalId> getRoots() {
+		auto roots = h.getConvertedVertices();
+		if (roots.size() > details::multiSource::MAX_ROOTS) {
+			LOG(WARNING) << "Only first " << details::multiSource::MAX_ROOTS << " of " << roots.size()
+			             << " roots will be traversed";
+			roots.resize(details::multiSource::MAX_ROOTS);
+		}
+		return roots;
+	}
+};
+
+#endif //FRAMEWORK_MULTISOURCEBFSASSEMBLY_H
@@ -5,18 +5,47 @@
 #ifndef FRAMEWORK_REPEATINGASSEMBLY_H
 #define FRAMEWORK_REPEATINGASSEMBLY_H
 
+#include <stdexcept>
 #include <Assembly.h>
 #include <Executor.h>
 
+namespace details { namespace RepeatingAssembly {
+	const std::string N_OPT = "ra-n";
+	const std::string NAME_OPT = "ra-name";
+	/* run the whole inner assembly (including graph loading) n times, instead of n iterations on a single graph */
+	const std::string RELOAD_OPT = "ra-reload";
+}}
+
+/**
+ * Runs inner AlgorithmAssembly with n measured iterations of the algorithm (see details::Assemblies), graph is loaded
+ * only once. Other options (e.g. warmup) are passed to the inner assembly unchanged.
+ * Other assemblies (see Assembly::supportsIterations) can only be repeated with RELOAD_OPT.
+ */
 class RepeatingAssembly : public Assembly {
 public:
 	void doRun(ConfigMap cmap) override {
-		std::string strN = cmap["ra-n"];
+		using namespace details::RepeatingAssembly;
+
+		std::string strN = cmap[N_OPT];
 		int n = std::stoi(strN);
-		std::string innerAssemblyName = cmap["ra-name"];
+		std::string innerAssemblyName = cmap[NAME_OPT];
+		auto* inner = parentExecutor->findAssembly(innerAssemblyName);
+		bool innerIterates = inner != nullptr && inner->supportsIterations();
 
-		for(int i = 0; i < n; i++) {
-			parentExecutor->executeAssembly(innerAssemblyName);
+		if (cmap.find(RELOAD_OPT) != cmap.end()) {
+			bool iterationsSet = cmap.find(details::Assemblies::ITERATIONS_OPT) != cmap.end() ||
+			                     cmap.find(details::Assemblies::WARMUP_OPT) != cmap.end();
+			if (iterationsSet && !innerIterates)
+				LOG(WARNING) << "Assembly " << innerAssemblyName << " ignores iteration & warmup options";
+			for(int i = 0; i < n; i++) {
+				parentExecutor->executeAssembly(innerAssemblyName, cmap);
+			}
+		} else {
+			if (!innerIterates)
+				throw std::runtime_error("Assembly " + innerAssemblyName + " doesn't support iterations, use " + RELOAD_OPT);
+			ConfigMap innerConfig = cmap;
+			innerConfig[details::Assemblies::ITERATIONS_OPT] = strN;
+			parentExecutor->executeAssembly(innerAssemblyName, innerConfig);
 		}
 	};
 };
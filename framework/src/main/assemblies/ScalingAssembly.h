@@ -0,0 +1,220 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#ifndef FRAMEWORK_SCALINGASSEMBLY_H
+#define FRAMEWORK_SCALINGASSEMBLY_H
+
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <mpi.h>
+#include <glog/logging.h>
+#include <Assembly.h>
+#include <utils/GraphGenerators.h>
+#include <utils/Probe.h>
+#include <utils/ProbeRegistry.h>
+#include <utils/RootSampling.h>
+
+namespace details { namespace Scaling {
+	/* comma separated; defaults to gen-scale */
+	const std::string SCALES_OPT = "sc-scales";
+	/* comma separated; defaults to all registered algorithms */
+	const std::string ALGORITHMS_OPT = "sc-algos";
+	const std::string REPETITIONS_OPT = "sc-reps";
+	/* CSV rows are appended to this file (header is written if it's empty); stdout is used when absent */
+	const std::string OUTPUT_OPT = "sc-out";
+	const int DEFAULT_REPETITIONS = 3;
+
+	const std::string CSV_HEADER = "ranks,graph,scale,edgefactor,algorithm,repetition,succeeded,seconds,"
+	                               "rank_seconds_min,rank_seconds_avg,rank_seconds_max,edges,messages,bytes";
+
+	inline std::vector<std::string> splitList(const std::string& list) {
+		std::vector<std::string> items;
+		std::stringstream ss(list);
+		std::string item;
+		while(std::getline(ss, item, ',')) {
+			if (!item.empty()) items.push_back(item);
+		}
+		return items;
+	}
+
+	/* sum of all counters with given name, regardless of the scope they were recorded in */
+	inline double sumCounters(const ReducedProbes& reduced, const std::string& name) {
+		double sum = 0.0;
+		std::string suffix = "/" + name;
+		for(auto& p: reduced.counters) {
+			auto& path = p.first;
+			if (path == name ||
+			    (path.size() > suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0))
+				sum += p.second.sum;
+		}
+		return sum;
+	}
+}}
+
+/* algorithm prepared for a single (timed) run; owns the algorithm and its result */
+using PreparedRun = std::function<bool(AAuxiliaryParams)>;
+
+/**
+ * Factories of prepared runs for ScalingAssembly. Preparation (e.g. choosing BFS roots) is collective and isn't timed;
+ * repetition number can be used to vary inputs between repetitions.
+ */
+namespace ScalingRuns {
+	template <typename G>
+	using Factory = std::function<PreparedRun(G&, size_t)>;
+
+	/* algorithms without constructor arguments, e.g. colouring */
+	template <template <typename> class TAlgorithm, typename G>
+	Factory<G> defaultConstructed() {
+		return [](G& g, size_t) {
+			auto algorithm = std::make_shared<TAlgorithm<G>>();
+			return PreparedRun([algorithm, &g](AAuxiliaryParams p) { return algorithm->run(&g, p); });
+		};
+	}
+
+	/* BFS from a random non-isolated root, different in each repetition */
+	template <template <typename> class TBfs, typename G>
+	Factory<G> bfs() {
+		return [](G& g, size_t repetition) {
+			auto roots = RootSampling::nonIsolated(g, 1, repetition + 1);
+			if (roots.empty()) throw std::runtime_error("Graph has no edges, cannot choose BFS root");
+			auto algorithm = std::make_shared<TBfs<G>>(roots[0]);
+			return PreparedRun([algorithm, &g](AAuxiliaryParams p) { return algorithm->run(&g, p); });
+		};
+	}
+
+	/* multi-source BFS from given number of random non-isolated roots */
+	template <template <typename> class TMsBfs, typename G>
+	Factory<G> multiSourceBfs(size_t rootCount) {
+		return [rootCount](G& g, size_t repetition) {
+			auto roots = RootSampling::nonIsolated(g, rootCount, repetition + 1);
+			if (roots.empty()) throw std::runtime_error("Graph has no edges, cannot choose BFS roots");
+			auto algorithm = std::make_shared<TMsBfs<G>>(roots);
+			return PreparedRun([algorithm, &g](AAuxiliaryParams p) { return algorithm->run(&g, p); });
+		};
+	}
+}
+
+/**
+ * Benchmark driver: for each graph scale generates the graph once and runs each selected algorithm several times on
+ * it (without validation), producing one CSV row per run on rank 0.
+ *
+ * Time of a run is measured on rank 0 between barriers; per-rank times and edges/messages/bytes come from
+ * ProbeRegistry (counters are summed over all ranks, scopes and levels).
+ *
+ * Number of ranks is fixed within one MPI job - sweeps over it (and speedup/efficiency) are done by
+ * framework/scaling.py, which runs this assembly under mpiexec.
+ *
+ * TGHandle is constructed like ABCGeneratedGraphHandle.
+ */
+template <typename TGHandle>
+class ScalingAssembly : public Assembly {
+	using G = typename TGHandle::GPType;
+
+public:
+	ScalingAssembly(GraphGenerators::Params baseParams) : baseParams(baseParams) {}
+
+	void addAlgorithm(std::string name, ScalingRuns::Factory<G> factory) {
+		algorithmNames.push_back(name);
+		factories.emplace(name, factory);
+	}
+
+	bool allSucceeded = false;
+
+protected:
+	void doRun(ConfigMap config) override {
+		using namespace details::Scaling;
+
+		int rank, size;
+		MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+		MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+		std::vector<unsigned> scales = {baseParams.scale};
+		if (config.find(SCALES_OPT) != config.end()) {
+			scales.clear();
+			for(auto& s: splitList(config[SCALES_OPT])) scales.push_back(static_cast<unsigned>(std::stoul(s)));
+		}
+		for(auto s: scales) {
+			/* same limit as in GraphGenerators::Params::fromConfig */
+			if (s > 30) throw std::runtime_error("Generated graphs are limited to scale 30");
+		}
+		auto algorithms = algorithmNames;
+		if (config.find(ALGORITHMS_OPT) != config.end()) algorithms = splitList(config[ALGORITHMS_OPT]);
+		for(auto& a: algorithms) {
+			if (factories.find(a) == factories.end())
+				throw std::runtime_error("ScalingAssembly: unknown algorithm " + a);
+		}
+		int repetitions = DEFAULT_REPETITIONS;
+		if (config.find(REPETITIONS_OPT) != config.end()) repetitions = std::stoi(config[REPETITIONS_OPT]);
+
+		std::ofstream file;
+		std::ostream* out = &std::cout;
+		if (rank == 0 && config.find(OUTPUT_OPT) != config.end()) {
+			file.open(config[OUTPUT_OPT], std::ofstream::app);
+			if (!file) throw std::runtime_error("Cannot open " + config[OUTPUT_OPT]);
+			out = &file;
+		}
+		if (rank == 0 && (out == &std::cout || file.tellp() == 0)) *out << CSV_HEADER << std::endl;
+
+		AAuxiliaryParams aaParams;
+		aaParams.config = config;
+		ProbeRegistry& registry = ProbeRegistry::instance();
+		allSucceeded = true;
+
+		for(auto scale: scales) {
+			auto params = baseParams;
+			params.scale = scale;
+			LOG(INFO) << "Scaling: generating graph of scale " << scale;
+			TGHandle handle(params, static_cast<size_t>(size), static_cast<size_t>(rank), {});
+			G& g = handle.getGraph();
+
+			for(auto& name: algorithms) {
+				for(int r = 0; r < repetitions; r++) {
+					auto run = factories.at(name)(g, static_cast<size_t>(r));
+					registry.reset();
+
+					MPI_Barrier(MPI_COMM_WORLD);
+					Probe probe("Scaling_" + name, true);
+					if (rank == 0) probe.start();
+					registry.enter("Algorithm");
+					bool succeeded = run(aaParams);
+					registry.leave();
+					MPI_Barrier(MPI_COMM_WORLD);
+					double seconds = 0.0;
+					if (rank == 0) seconds = std::chrono::duration<double>(probe.stop()).count();
+
+					bool allRanksSucceeded = false;
+					MPI_Allreduce(&succeeded, &allRanksSucceeded, 1, MPI_CXX_BOOL, MPI_LAND, MPI_COMM_WORLD);
+					allSucceeded = allSucceeded && allRanksSucceeded;
+					auto reduced = registry.reduce();
+
+					if (rank == 0) {
+						auto& rankSeconds = reduced.timerSeconds.at("Algorithm");
+						*out << size << "," << GraphGenerators::kindName(params.kind) << "," << scale << ","
+						     << params.edgeFactor << "," << name << "," << r << "," << (allRanksSucceeded ? 1 : 0) << ","
+						     << seconds << "," << rankSeconds.min << "," << rankSeconds.avg << "," << rankSeconds.max << ","
+						     << sumCounters(reduced, "edges") << "," << sumCounters(reduced, "messages") << ","
+						     << sumCounters(reduced, "bytes") << std::endl;
+					}
+				}
+			}
+
+			handle.releaseGraph();
+		}
+	}
+
+private:
+	GraphGenerators::Params baseParams;
+	std::vector<std::string> algorithmNames;
+	std::map<std::string, ScalingRuns::Factory<G>> factories;
+};
+
+#endif //FRAMEWORK_SCALINGASSEMBLY_H
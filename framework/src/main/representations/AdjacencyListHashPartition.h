@@ -17,6 +17,7 @@
 #include <utils/AdjacencyListReader.h>
 #include <utils/Probe.h>
 #include "shared.h"
+#include "GhostLayer.h"
 
 
 
@@ -67,7 +68,8 @@ private:
 	using Gd = details::GraphData<LocalId, GlobalId>;
 
 public:
-	ALHPGraphPartition(Gd ds) : data(ds), vCount(ds.vertexEdgeWinMem[0]), eCount(ds.vertexEdgeWinMem[1]) {};
+	ALHPGraphPartition(Gd ds)
+			: data(ds), vCount(ds.vertexEdgeWinMem[0]), eCount(ds.vertexEdgeWinMem[1]), ghosts(nullptr) {};
 	ALHPGraphPartition(const ALHPGraphPartition&) = delete;
 	ALHPGraphPartition& operator=(const ALHPGraphPartition&) = delete;
 	ALHPGraphPartition(ALHPGraphPartition&& g) = default;
@@ -160,12 +162,39 @@ public:
 		}
 	};
 
+	/*
+	 * Ghost layer (opt-in, see ALHGraphHandle::GHOSTS_OPT and GhostLayer)
+	 */
+
+	bool hasGhosts() {
+		return ghosts != nullptr;
+	}
+
+	size_t ghostVerticesCount() {
+		return hasGhosts() ? ghosts->ghostsCount() : 0;
+	}
+
+	LocalId toGhostId(const GlobalId gid, bool* isGhost = nullptr) {
+		assert(hasGhosts());
+		return ghosts->toGhostId(gid.nodeId, gid.localId, isGhost);
+	}
+
+	/**
+	 * @param stateArray - must hold masterVerticesMaxCount() + ghostVerticesCount() elements
+	 */
+	template <typename T>
+	void refreshGhosts(T* stateArray, MPI_Datatype dt = getDatatypeFor<T>()) {
+		assert(hasGhosts());
+		ghosts->refreshGhosts(stateArray, dt);
+	}
+
 	~ALHPGraphPartition() {}
 
 private:
 	Gd data;
 	TLocalId vCount;
 	TLocalId eCount;
+	GhostLayer<ALHPGraphPartition>* ghosts;
 
 	friend ALHGraphHandle<LocalId, NumericId>;
 };
@@ -189,6 +218,8 @@ public:
 
 	static const std::string E_DIV_OPT;
 	static const std::string V_DIV_OPT;
+	/* when present, ghost layer is built right after loading */
+	static const std::string GHOSTS_OPT;
 
 private:
 	std::pair<G*, std::vector<GlobalId>> buildGraph(std::vector<OriginalVertexId> verticesToConvert,
@@ -477,6 +508,12 @@ private:
 
 		auto cvv = std::vector<GlobalId> (convertedVertices, convertedVertices + vertToConvCount);
 		auto *gp = new ALHPGraphPartition<LocalId, NumericId>(d);
+
+		if (cm.find(GHOSTS_OPT) != cm.end()) {
+			LOG(INFO) << "Building ghost layer";
+			gp->ghosts = new GhostLayer<G>(*gp);
+		}
+
 		return std::make_pair(gp, cvv);
 	}
 
@@ -487,6 +524,7 @@ private:
 
 	static void destroyGraph(G* g) {
 		MPI_Type_free(&(g->data.gIdDatatype));
+		if (g->ghosts != nullptr) delete g->ghosts;
 		delete g;
 	}
 };
@@ -495,5 +533,7 @@ template <typename T1, typename T2>
 const std::string ALHGraphHandle<T1,T2>::E_DIV_OPT = "ediv";
 template <typename T1, typename T2>
 const std::string ALHGraphHandle<T1,T2>::V_DIV_OPT = "vdiv";
+template <typename T1, typename T2>
+const std::string ALHGraphHandle<T1,T2>::GHOSTS_OPT = "ghosts";
 
 #endif //FRAMEWORK_ADJACENCYLISTHASHPARTITION_H
@@ -7,7 +7,13 @@
 
 #include <algorithm>
 #include <climits>
+#include <cstdint>
+#include <limits>
 #include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 #include <glog/logging.h>
 #include <boost/pool/object_pool.hpp>
 #include <GraphPartition.h>
@@ -44,28 +50,104 @@ struct ABCPGlobalVertexId {
 	bool operator!=(const ABCPGlobalVertexId& o) const {
 		return !operator==(o);
 	}
+
+	static bool canRepresent(size_t nodeCount, size_t maxLocalCount) {
+		return nodeCount <= static_cast<size_t>(std::numeric_limits<NodeId>::max()) &&
+		       (maxLocalCount == 0 || maxLocalCount - 1 <= static_cast<size_t>(std::numeric_limits<T>::max()));
+	}
+};
+
+/**
+ * Drop-in replacement for ABCPGlobalVertexId (same fields) packed into a single 64-bit word: RankBits for the owner
+ * (signed, so that invalid id still has negative nodeId) and the rest for local id. Compared to the struct with
+ * 64-bit local id it's half the size, which applies to adjacency, per-vertex arrays of algorithms and messages, and
+ * it's transferred as a plain MPI_UINT64_T.
+ *
+ * Opt-in via the last template parameter of ArrayBackedChunkedPartition and its handles.
+ */
+template <unsigned RankBits = 16>
+struct ABCPPackedGlobalVertexId {
+	static_assert(RankBits > 1 && RankBits < 64, "both parts must have at least one bit");
+
+	ABCPPackedGlobalVertexId() : nodeId(-1), localId(0) {}
+	ABCPPackedGlobalVertexId(NodeId nodeId, uint64_t localId) : nodeId(nodeId), localId(localId) {}
+
+	int64_t nodeId : RankBits;
+	uint64_t localId : 64 - RankBits;
+
+	static MPI_Datatype mpiDatatype() {
+		/* duplicated, so that it can be committed & freed like the ones created for structs */
+		MPI_Datatype d;
+		MPI_Type_dup(MPI_UINT64_T, &d);
+		return d;
+	}
+
+	bool operator==(const ABCPPackedGlobalVertexId& o) const {
+		return nodeId == o.nodeId && localId == o.localId;
+	}
+
+	bool operator!=(const ABCPPackedGlobalVertexId& o) const {
+		return !operator==(o);
+	}
+
+	static bool canRepresent(size_t nodeCount, size_t maxLocalCount) {
+		return nodeCount <= (1ULL << (RankBits - 1)) && maxLocalCount <= (1ULL << (64 - RankBits));
+	}
+};
+static_assert(sizeof(ABCPPackedGlobalVertexId<>) == sizeof(uint64_t), "packed id must fit in a single word");
+
+/**
+ * Adjacency of ArrayBackedChunkedPartition in CSR form - neighbours of local vertex v are
+ * neighbours[offsets[v]] ... neighbours[offsets[v+1] - 1]. Filled in a single pass, vertex after vertex in order of
+ * local ids.
+ */
+template <typename TGlobalId>
+struct ABCPAdjacency {
+	std::vector<size_t> offsets = {0};
+	std::vector<TGlobalId> neighbours;
+
+	void addNeighbour(TGlobalId n) {
+		neighbours.push_back(n);
+	}
+
+	/* closes neighbour list of the current vertex, further neighbours belong to the next one */
+	void endVertex() {
+		offsets.push_back(neighbours.size());
+	}
+
+	size_t vertexCount() const {
+		return offsets.size() - 1;
+	}
 };
 
 /*
  * For this representation, toNumeric always returns original ID (as loaded from file).
  */
-template <typename TLocalId, typename TNumId>
-class ArrayBackedChunkedPartition : public GraphPartition<ABCPGlobalVertexId<TLocalId>, TLocalId, TNumId> {
+template <typename TLocalId, typename TNumId, typename TGlobalId = ABCPGlobalVertexId<TLocalId>>
+class ArrayBackedChunkedPartition : public GraphPartition<TGlobalId, TLocalId, TNumId> {
 private:
-	using P = GraphPartition<ABCPGlobalVertexId<TLocalId>, TLocalId, TNumId>;
+	using P = GraphPartition<TGlobalId, TLocalId, TNumId>;
 	IMPORT_ALIASES(P)
 
 public:
-	ArrayBackedChunkedPartition(std::vector<GlobalId> *adjList,
-	                            size_t vertexCount,
+	ArrayBackedChunkedPartition(ABCPAdjacency<GlobalId> adjacency,
 	                            size_t vertexMaxCount,
 	                            NodeId nodeId,
 	                            size_t partitionOffset,
 	                            size_t allVerticesCount,
 	                            size_t partitionCount)
-			: adjacencyList(adjList), localVertexCount(vertexCount), nodeId(nodeId), partitionOffset(partitionOffset),
-			  localVertexMaxCount(vertexMaxCount), allVerticesCount(allVerticesCount), partitionCount(partitionCount)
+			: partitions(static_cast<int>(allVerticesCount), static_cast<int>(partitionCount)),
+			  localVertexMaxCount(vertexMaxCount), adjacency(std::move(adjacency)), nodeId(nodeId),
+			  partitionOffset(partitionOffset)
 	{
+		if (!GlobalId::canRepresent(partitionCount, vertexMaxCount))
+			throw std::runtime_error("ArrayBackedChunkedPartition: global id type too narrow for " +
+			                         std::to_string(partitionCount) + " partitions of " +
+			                         std::to_string(vertexMaxCount) + " vertices");
+		localVertexCount = this->adjacency.vertexCount();
+		/* builders append, so capacity can be well above size */
+		this->adjacency.offsets.shrink_to_fit();
+		this->adjacency.neighbours.shrink_to_fit();
 		gIdDatatype = MPI_DATATYPE_NULL;
 	};
 
@@ -74,7 +156,7 @@ public:
 		 * MPI runtime being initialized (i.e. in tests)
 		 */
 		if(gIdDatatype == MPI_DATATYPE_NULL) {
-			gIdDatatype = ABCPGlobalVertexId<LocalId>::mpiDatatype();
+			gIdDatatype = GlobalId::mpiDatatype();
 			MPI_Type_commit(&gIdDatatype);
 		}
 
@@ -90,9 +172,7 @@ public:
 		return GlobalId(nodeId, lid);
 	};
 	NumericId toNumeric(const GlobalId gid) {
-		auto ownersPartitionOffset =
-				IndexPartitioner::get_range_for_partition(allVerticesCount, partitionCount, gid.nodeId).first;
-		return ownersPartitionOffset + gid.localId;
+		return partitions.partitionStart(gid.nodeId) + gid.localId;
 	};
 	NumericId toNumeric(const TLocalId lid) { return partitionOffset + lid; };
 	std::string idToString(const GlobalId gid) {
@@ -137,11 +217,12 @@ public:
 	 */
 	void foreachNeighbouringVertex(TLocalId id, std::function<ITER_PROGRESS (const GlobalId)> f) {
 		assert(id < localVertexCount);
-		auto neighbourList = adjacencyList[id];
+		const GlobalId *neighbours = adjacency.neighbours.data();
+		auto end = adjacency.offsets[id + 1];
 
 		ITER_PROGRESS ip = CONTINUE;
-		for(size_t neighId = 0; neighId < neighbourList.size() && ip == CONTINUE; neighId++) {
-			ip = f(neighbourList.at(neighId));
+		for(auto i = adjacency.offsets[id]; i < end && ip == CONTINUE; i++) {
+			ip = f(neighbours[i]);
 		}
 	};
 
@@ -152,12 +233,11 @@ public:
 	};
 
 private:
-	size_t allVerticesCount;
-	size_t partitionCount;
+	IndexPartitioner::PartitionTable partitions;
 
 	size_t localVertexCount;
 	size_t localVertexMaxCount;
-	std::vector<ABCPGlobalVertexId<LocalId>> *adjacencyList;
+	ABCPAdjacency<GlobalId> adjacency;
 
 	NodeId nodeId;
 	size_t partitionOffset;
@@ -165,10 +245,10 @@ private:
 	MPI_Datatype gIdDatatype;
 };
 
-template <typename TLocalId, typename TNumId>
-class ABCGraphHandle : public GraphPartitionHandle<ArrayBackedChunkedPartition<TLocalId, TNumId>> {
+template <typename TLocalId, typename TNumId, typename TGlobalId = ABCPGlobalVertexId<TLocalId>>
+class ABCGraphHandle : public GraphPartitionHandle<ArrayBackedChunkedPartition<TLocalId, TNumId, TGlobalId>> {
 private:
-	using G = ArrayBackedChunkedPartition<TLocalId, TNumId>;
+	using G = ArrayBackedChunkedPartition<TLocalId, TNumId, TGlobalId>;
 	using P = GraphPartitionHandle<G>;
 	IMPORT_ALIASES(G)
 
@@ -189,41 +269,43 @@ protected:
 		/* read headers to learn how much vertices present */
 		AdjacencyListReader<OriginalVertexId> reader(path);
 		auto vCount = reader.getVertexCount();
+		PartitionTable partitions(vCount, partitionsCount);
 
 		/* get our range */
-		auto range = get_range_for_partition(vCount, partitionsCount, partitionId);
+		auto range = partitions.range(partitionId);
 		auto partitionStart = range.first;
 		size_t vertexCount = range.second - range.first;
 
-		// skip vertices that are not our responsibility
-		for(int i = 0; i < partitionStart; i++) {
-			reader.getNextVertex();
-		}
+		/* skip vertices that are not our responsibility - without reading them, so that loading time depends only on
+		 * the size of our part of the file */
+		if (vertexCount > 0) reader.seekToVertex(partitionStart);
 
-		auto* allLocalVertices = new std::vector<GlobalId>[vertexCount];
+		ABCPAdjacency<GlobalId> adjacency;
+		adjacency.offsets.reserve(vertexCount + 1);
 		for(size_t i = 0; i < vertexCount; i++) {
-			VertexSpec<OriginalVertexId> vs = *reader.getNextVertex();
-			auto idFrom0 = vs.vertexId - partitionStart;
-			std::transform(vs.neighbours.begin(), vs.neighbours.end(), std::back_inserter(allLocalVertices[idFrom0]),
-			               [=](OriginalVertexId nid) {
-				               auto targetPartition = get_partition_from_index(vCount, partitionsCount, nid);
-				               auto targetPartitionStart = get_range_for_partition(vCount, partitionsCount, targetPartition).first;
-				               return ABCPGlobalVertexId<LocalId>(targetPartition,
-				                                                  static_cast<TLocalId>(nid) - targetPartitionStart);
-			               });
+			auto ovs = reader.getNextVertex();
+			if (ovs == boost::none || ovs->vertexId != partitionStart + i) {
+				throw std::runtime_error(path + ": expected line of vertex " + std::to_string(partitionStart + i) +
+				                         " (lines must be sorted and describe every vertex)");
+			}
+			for(OriginalVertexId nid: ovs->neighbours) {
+				auto targetPartition = partitions.partitionOf(nid);
+				adjacency.addNeighbour(GlobalId(
+						targetPartition, static_cast<TLocalId>(nid) - partitions.partitionStart(targetPartition)));
+			}
+			adjacency.endVertex();
 		}
 
 		/* convert vertices */
 		std::vector<GlobalId> convertedVertices;
 		for(auto oId: verticesToConvert) {
-			int partitionId = IndexPartitioner::get_partition_from_index(reader.getVertexCount(), partitionsCount, oId);
-			int rangeStart = IndexPartitioner::get_range_for_partition(reader.getVertexCount(), partitionsCount, partitionId).first;
-			convertedVertices.push_back(ABCPGlobalVertexId<LocalId>(partitionId, oId - rangeStart));
+			int partitionId = partitions.partitionOf(oId);
+			convertedVertices.push_back(GlobalId(partitionId, oId - partitions.partitionStart(partitionId)));
 		}
 
 		/* if anybody gets more than others, it'll be first partition */
-		auto longestRange = IndexPartitioner::get_range_for_partition(vCount, partitionsCount, 0);
-		auto* gp =  new G(allLocalVertices, vertexCount, longestRange.second - longestRange.first,
+		auto longestRange = partitions.range(0);
+		auto* gp =  new G(std::move(adjacency), longestRange.second - longestRange.first,
 		                  partitionId, partitionStart, vCount, partitionsCount);
 
 		return std::make_pair(gp, convertedVertices);
@@ -0,0 +1,237 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#ifndef FRAMEWORK_GENERATEDGRAPHHANDLE_H
+#define FRAMEWORK_GENERATEDGRAPHHANDLE_H
+
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <mpi.h>
+#include <glog/logging.h>
+#include <GraphPartitionHandle.h>
+#include <representations/ArrayBackedChunkedPartition.h>
+#include <utils/GraphGenerators.h>
+#include <utils/IndexPartitioner.h>
+#include <utils/MpiTypemap.h>
+
+/**
+ * Builds ArrayBackedChunkedPartition from a graph generated in memory (any of GraphGenerators, as selected by
+ * params.kind), instead of reading it from file.
+ *
+ * Each node generates its share of the edge list, then edges (in both directions) are sent to owners of
+ * source vertices with alltoallv. Owners drop duplicates; self-loops are dropped before sending.
+ * Vertices are assigned to partitions the same way as in ABCGraphHandle.
+ *
+ * Counts are 64-bit and the exchange is split into as many alltoallv rounds as needed for per-round counts and
+ * displacements to fit in int (EXCHANGE_CHUNK_OPT lowers the per-peer limit).
+ *
+ * Building is a collective operation (MPI_COMM_WORLD).
+ */
+template <typename TLocalId, typename TNumId, typename TGlobalId = ABCPGlobalVertexId<TLocalId>>
+class ABCGeneratedGraphHandle : public GraphPartitionHandle<ArrayBackedChunkedPartition<TLocalId, TNumId, TGlobalId>> {
+private:
+	using G = ArrayBackedChunkedPartition<TLocalId, TNumId, TGlobalId>;
+	using P = GraphPartitionHandle<G>;
+	IMPORT_ALIASES(G)
+
+public:
+	ABCGeneratedGraphHandle(GraphGenerators::Params params,
+	                        size_t partitionCount,
+	                        size_t partitionId,
+	                        std::vector<OriginalVertexId> verticesToConvert,
+	                        GBAuxiliaryParams auxParams = GBAuxiliaryParams())
+			: P(verticesToConvert, destroyGraph, auxParams), params(params), partitionsCount(partitionCount),
+			  partitionId(partitionId) {};
+
+	/* max. number of ids sent to a single peer in one alltoallv round */
+	static const std::string EXCHANGE_CHUNK_OPT;
+
+	const GraphGenerators::Params& getGeneratorParams() { return params; }
+
+	/* seconds this node spent generating its slice of the edge list, known once the graph has been built */
+	double getGenerationTime() { return generationTime; }
+	/* seconds this node spent on exchanging edges & building the partition */
+	double getConstructionTime() { return constructionTime; }
+
+protected:
+	std::pair<G*, std::vector<GlobalId>> buildGraph(std::vector<OriginalVertexId> verticesToConvert,
+	                                                GBAuxiliaryParams auxParams) override {
+		using namespace IndexPartitioner;
+		using GraphGenerators::Edge;
+		using Clock = std::chrono::steady_clock;
+
+		/* IndexPartitioner & local ids are int-based */
+		if (params.vertexCount() > static_cast<OriginalVertexId>(std::numeric_limits<int>::max()))
+			throw std::runtime_error("Generated graph of scale " + std::to_string(params.scale) +
+			                         " has too many vertices for int-based partitioning");
+
+		const int vCount = static_cast<int>(params.vertexCount());
+		const int pCount = static_cast<int>(partitionsCount);
+		const PartitionTable partitions(vCount, pCount);
+
+		/* generate our slice of the edge list */
+		auto generationStart = Clock::now();
+		const unsigned long long eCount = params.edgeCount();
+		auto edgeFrom = eCount*partitionId/partitionsCount;
+		auto edgeTo = eCount*(partitionId + 1)/partitionsCount;
+		std::vector<Edge> generated;
+		generated.reserve(edgeTo - edgeFrom);
+		GraphGenerators::generate(params, edgeFrom, edgeTo, generated);
+		auto constructionStart = Clock::now();
+		generationTime = seconds(constructionStart - generationStart);
+
+		/* route both directions to owners of source vertices */
+		auto outgoing = new std::vector<OriginalVertexId>[partitionsCount];
+		for(auto& e: generated) {
+			if (e.first == e.second) continue;
+
+			auto& toFirst = outgoing[partitions.partitionOf(static_cast<int>(e.first))];
+			toFirst.push_back(e.first);
+			toFirst.push_back(e.second);
+			auto& toSecond = outgoing[partitions.partitionOf(static_cast<int>(e.second))];
+			toSecond.push_back(e.second);
+			toSecond.push_back(e.first);
+		}
+		generated.clear();
+		generated.shrink_to_fit();
+
+		std::vector<Edge> received = exchange(outgoing, chunkSize(auxParams));
+		delete[] outgoing;
+
+		/* symmetric already, only duplicates need to be removed */
+		std::sort(received.begin(), received.end());
+		received.erase(std::unique(received.begin(), received.end()), received.end());
+
+		auto range = partitions.range(static_cast<int>(partitionId));
+		size_t vertexCount = range.second - range.first;
+		/* edges are sorted by source, so adjacency is built in a single pass */
+		ABCPAdjacency<GlobalId> adjacency;
+		adjacency.offsets.reserve(vertexCount + 1);
+		adjacency.neighbours.reserve(received.size());
+		size_t e = 0;
+		for(size_t v = 0; v < vertexCount; v++) {
+			for(; e < received.size() && received[e].first - range.first == v; e++) {
+				adjacency.addNeighbour(toGlobalId(partitions, received[e].second));
+			}
+			adjacency.endVertex();
+		}
+
+		std::vector<GlobalId> convertedVertices;
+		for(auto oId: verticesToConvert) {
+			convertedVertices.push_back(toGlobalId(partitions, oId));
+		}
+
+		LOG(INFO) << "Generated graph: " << vertexCount << " local vertices, " << received.size()
+		          << " local (directed) edges";
+
+		/* if anybody gets more than others, it'll be first partition */
+		auto longestRange = partitions.range(0);
+		auto* gp = new G(std::move(adjacency), longestRange.second - longestRange.first,
+		                 partitionId, range.first, vCount, partitionsCount);
+		constructionTime = seconds(Clock::now() - constructionStart);
+
+		return std::make_pair(gp, convertedVertices);
+	};
+
+private:
+	GraphGenerators::Params params;
+	size_t partitionsCount;
+	size_t partitionId;
+	double generationTime = 0.0;
+	double constructionTime = 0.0;
+
+	static double seconds(std::chrono::steady_clock::duration d) {
+		return std::chrono::duration_cast<std::chrono::duration<double>>(d).count();
+	}
+
+	/* even, so that edges (pairs of ids) are never split between rounds */
+	size_t chunkSize(GBAuxiliaryParams& auxParams) {
+		size_t chunk = static_cast<size_t>(std::numeric_limits<int>::max())/partitionsCount;
+		auto it = auxParams.configMap.find(EXCHANGE_CHUNK_OPT);
+		if (it != auxParams.configMap.end()) chunk = std::min(chunk, static_cast<size_t>(std::stoull(it->second)));
+		chunk -= chunk%2;
+		if (chunk == 0) throw std::runtime_error(EXCHANGE_CHUNK_OPT + " must allow at least one edge per round");
+		return chunk;
+	}
+
+	/**
+	 * Sends outgoing[i] to partition i and returns everything sent to this one as edges. In each round at most chunk
+	 * ids go to every peer, so totals of a round (and all displacements) stay below INT_MAX. Collective.
+	 */
+	std::vector<GraphGenerators::Edge> exchange(std::vector<OriginalVertexId>* outgoing, size_t chunk) {
+		const int pCount = static_cast<int>(partitionsCount);
+
+		std::vector<unsigned long long> sendTotals(partitionsCount), recvTotals(partitionsCount);
+		unsigned long long localRounds = 0, recvTotal = 0;
+		for(size_t i = 0; i < partitionsCount; i++) {
+			sendTotals[i] = outgoing[i].size();
+			localRounds = std::max(localRounds, (sendTotals[i] + chunk - 1)/chunk);
+		}
+		MPI_Alltoall(sendTotals.data(), 1, MPI_UNSIGNED_LONG_LONG, recvTotals.data(), 1, MPI_UNSIGNED_LONG_LONG,
+		             MPI_COMM_WORLD);
+		unsigned long long rounds = 0;
+		MPI_Allreduce(&localRounds, &rounds, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, MPI_COMM_WORLD);
+		for(auto c: recvTotals) recvTotal += c;
+
+		std::vector<GraphGenerators::Edge> received;
+		received.reserve(recvTotal/2);
+
+		auto dt = getDatatypeFor<OriginalVertexId>();
+		std::vector<int> sendCounts(partitionsCount), sendDispls(partitionsCount);
+		std::vector<int> recvCounts(partitionsCount), recvDispls(partitionsCount);
+		std::vector<OriginalVertexId> sendBuffer, recvBuffer;
+		for(unsigned long long round = 0; round < rounds; round++) {
+			auto offset = round*chunk;
+			auto inRound = [offset, chunk](unsigned long long total) {
+				if (total <= offset) return 0;
+				return static_cast<int>(std::min(total - offset, static_cast<unsigned long long>(chunk)));
+			};
+
+			sendBuffer.clear();
+			int sendTotal = 0, roundRecvTotal = 0;
+			for(int i = 0; i < pCount; i++) {
+				sendCounts[i] = inRound(sendTotals[i]);
+				sendDispls[i] = sendTotal;
+				sendTotal += sendCounts[i];
+				/* offset may be past the end of ids of this peer */
+				if (sendCounts[i] > 0) {
+					sendBuffer.insert(sendBuffer.end(), outgoing[i].begin() + offset,
+					                  outgoing[i].begin() + offset + sendCounts[i]);
+				}
+
+				recvCounts[i] = inRound(recvTotals[i]);
+				recvDispls[i] = roundRecvTotal;
+				roundRecvTotal += recvCounts[i];
+			}
+			recvBuffer.resize(static_cast<size_t>(roundRecvTotal));
+
+			MPI_Alltoallv(sendBuffer.data(), sendCounts.data(), sendDispls.data(), dt,
+			              recvBuffer.data(), recvCounts.data(), recvDispls.data(), dt, MPI_COMM_WORLD);
+
+			for(int i = 0; i < roundRecvTotal; i += 2) {
+				received.push_back(std::make_pair(recvBuffer[i], recvBuffer[i+1]));
+			}
+		}
+
+		return received;
+	}
+
+	static GlobalId toGlobalId(const IndexPartitioner::PartitionTable& partitions, OriginalVertexId oId) {
+		int targetPartition = partitions.partitionOf(static_cast<int>(oId));
+		return GlobalId(targetPartition, static_cast<LocalId>(oId - partitions.partitionStart(targetPartition)));
+	}
+
+	static void destroyGraph(G* g) {
+		delete g;
+	}
+};
+
+template <typename TLocalId, typename TNumId, typename TGlobalId>
+const std::string ABCGeneratedGraphHandle<TLocalId, TNumId, TGlobalId>::EXCHANGE_CHUNK_OPT = "gen-chunk";
+
+#endif //FRAMEWORK_GENERATEDGRAPHHANDLE_H
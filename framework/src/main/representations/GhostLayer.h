@@ -0,0 +1,153 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#ifndef FRAMEWORK_GHOSTLAYER_H
+#define FRAMEWORK_GHOSTLAYER_H
+
+#include <vector>
+#include <algorithm>
+#include <mpi.h>
+#include <glog/logging.h>
+#include <GraphPartition.h>
+#include <utils/NonCopyable.h>
+#include <utils/MpiTypemap.h>
+
+/**
+ * Local copies (ghosts, halo) of state of remote neighbours for 1D partitions.
+ *
+ * Built once from partition's adjacency: each remote neighbour (deduplicated) gets dense ghost LocalId. Ghost ids
+ * start at masterVerticesMaxCount() (so, as required by GraphPartition, they never collide with masters) and are
+ * grouped by the owner node.
+ *
+ * Ghosts are not shadows - they carry no neighbourship information and toLocalId() is not affected by them, so
+ * existing 1D algorithms (which send toLocalId() of remote vertex to its owner) keep working. To reach ghost
+ * use toGhostId().
+ *
+ * Per-vertex state arrays used with refreshGhosts must have room for masterVerticesMaxCount() + ghostsCount()
+ * elements.
+ *
+ * Construction and refreshGhosts are collective operations (MPI_COMM_WORLD).
+ */
+template <class TGraphPartition>
+class GhostLayer : NonCopyable {
+	IMPORT_ALIASES(TGraphPartition)
+
+public:
+	GhostLayer(TGraphPartition& g) : firstGhost(static_cast<LocalId>(g.masterVerticesMaxCount())) {
+		MPI_Comm_rank(MPI_COMM_WORLD, &nodeId);
+		MPI_Comm_size(MPI_COMM_WORLD, &worldSize);
+
+		/* gather ids of remote neighbours, grouped by owner */
+		requested.resize(worldSize);
+		g.foreachMasterVertex([&](const LocalId vid) {
+			g.foreachNeighbouringVertex(vid, [&](const GlobalId nid) {
+				auto owner = g.toMasterNodeId(nid);
+				if (owner != nodeId) requested[owner].push_back(g.toLocalId(nid));
+				return ITER_PROGRESS::CONTINUE;
+			});
+			return ITER_PROGRESS::CONTINUE;
+		});
+
+		ghostCounts.resize(worldSize);
+		ghostDispls.resize(worldSize);
+		size_t total = 0;
+		for(NodeId i = 0; i < worldSize; i++) {
+			auto& r = requested[i];
+			std::sort(r.begin(), r.end());
+			r.erase(std::unique(r.begin(), r.end()), r.end());
+			ghostCounts[i] = static_cast<int>(r.size());
+			ghostDispls[i] = static_cast<int>(total);
+			total += r.size();
+		}
+		ghostCount = total;
+
+		/* tell owners which of their masters we are interested in - they'll be sending them on each refresh */
+		servedCounts.resize(worldSize);
+		servedDispls.resize(worldSize);
+		MPI_Alltoall(ghostCounts.data(), 1, MPI_INT, servedCounts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+		size_t servedTotal = 0;
+		for(NodeId i = 0; i < worldSize; i++) {
+			servedDispls[i] = static_cast<int>(servedTotal);
+			servedTotal += servedCounts[i];
+		}
+
+		std::vector<LocalId> requestedFlat;
+		requestedFlat.reserve(ghostCount);
+		for(auto& r: requested) requestedFlat.insert(requestedFlat.end(), r.begin(), r.end());
+
+		served.resize(servedTotal);
+		auto lidDt = getDatatypeFor<LocalId>();
+		MPI_Alltoallv(requestedFlat.data(), ghostCounts.data(), ghostDispls.data(), lidDt,
+		              served.data(), servedCounts.data(), servedDispls.data(), lidDt, MPI_COMM_WORLD);
+
+		LOG(INFO) << "Ghost layer built: " << ghostCount << " ghosts, " << servedTotal << " masters served";
+	}
+
+	LocalId firstGhostId() { return firstGhost; }
+	size_t ghostsCount() { return ghostCount; }
+
+	/**
+	 * Works only for remote neighbours of local masters, for any other vertex rubbish is returned and isGhost
+	 * (if not nullptr) is set to false
+	 */
+	LocalId toGhostId(NodeId owner, LocalId ownersLocalId, bool* isGhost = nullptr) {
+		if (owner < 0 || owner >= worldSize || owner == nodeId) {
+			if (isGhost != nullptr) *isGhost = false;
+			return 0;
+		}
+
+		auto& r = requested[owner];
+		auto it = std::lower_bound(r.begin(), r.end(), ownersLocalId);
+		bool found = it != r.end() && *it == ownersLocalId;
+		if (isGhost != nullptr) *isGhost = found;
+		return firstGhost + ghostDispls[owner] + static_cast<LocalId>(it - r.begin());
+	}
+
+	/* f receives ghost LocalId, owner and owner's LocalId */
+	void foreachGhost(std::function<ITER_PROGRESS (const LocalId, const NodeId, const LocalId)> f) {
+		ITER_PROGRESS ip = CONTINUE;
+		for(NodeId owner = 0; owner < worldSize && ip == CONTINUE; owner++) {
+			auto& r = requested[owner];
+			for(size_t i = 0; i < r.size() && ip == CONTINUE; i++) {
+				ip = f(firstGhost + ghostDispls[owner] + static_cast<LocalId>(i), owner, r[i]);
+			}
+		}
+	}
+
+	/**
+	 * Copies current values of masters into ghost slots on every node that has them as ghosts
+	 * (single alltoallv)
+	 */
+	template <typename T>
+	void refreshGhosts(T* stateArray, MPI_Datatype dt = getDatatypeFor<T>()) {
+		sendBuffer.resize(served.size()*sizeof(T));
+		T* packed = reinterpret_cast<T*>(sendBuffer.data());
+		for(size_t i = 0; i < served.size(); i++) {
+			packed[i] = stateArray[served[i]];
+		}
+
+		MPI_Alltoallv(packed, servedCounts.data(), servedDispls.data(), dt,
+		              stateArray + firstGhost, ghostCounts.data(), ghostDispls.data(), dt, MPI_COMM_WORLD);
+	}
+
+private:
+	NodeId nodeId;
+	int worldSize;
+	const LocalId firstGhost;
+	size_t ghostCount;
+
+	/* per owner: sorted owner-side LocalIds of our ghosts; position in it (+ displacement) gives ghost id */
+	std::vector<std::vector<LocalId>> requested;
+	std::vector<int> ghostCounts;
+	std::vector<int> ghostDispls;
+
+	/* our masters requested by other nodes, in order expected by them */
+	std::vector<LocalId> served;
+	std::vector<int> servedCounts;
+	std::vector<int> servedDispls;
+
+	std::vector<char> sendBuffer;
+};
+
+#endif //FRAMEWORK_GHOSTLAYER_H
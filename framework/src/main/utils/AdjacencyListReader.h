@@ -5,6 +5,7 @@
 #ifndef FRAMEWORK_ADJACENCYLISTREADER_H
 #define FRAMEWORK_ADJACENCYLISTREADER_H
 
+#include <limits>
 #include <string>
 #include <vector>
 #include <set>
@@ -53,11 +54,40 @@ public:
 		}
 	}
 
+	/**
+	 * Positions reader so that the next vertex returned is the first one with id >= vid, without parsing the preceding
+	 * ones. Lines are binary searched by vertex id, so they must be sorted (as in .adjl files, where line of vertex i
+	 * is the i-th one), which makes it O(log(file size)) line reads.
+	 */
+	void seekToVertex(TVertexId vid) {
+		if(!initialized) initialize();
+
+		auto low = dataStart;
+		auto high = csvReader.size();
+		while(low < high) {
+			auto mid = low + (high - low)/2;
+			if (vertexIdAt(csvReader.lineStartFrom(mid)) >= vid) high = mid;
+			else low = mid + 1;
+		}
+
+		csvReader.seek(csvReader.lineStartFrom(low));
+	}
+
 private:
 	CsvReader<TVertexId> csvReader;
 	size_t vertexCount;
 	size_t edgeCount;
 	bool initialized;
+	/* offset of the first vertex line */
+	std::streamoff dataStart = 0;
+
+	/* id of vertex described by line starting at given offset; max value past the last line */
+	TVertexId vertexIdAt(std::streamoff lineStart) {
+		csvReader.seek(lineStart);
+		auto line = csvReader.getNextLine();
+		if (line == boost::none || line->empty()) return std::numeric_limits<TVertexId>::max();
+		return (*line)[0];
+	}
 
 	void initialize() {
 		auto optionalVertexLine = csvReader.getNextLine();
@@ -70,6 +100,7 @@ private:
 
 		vertexCount = (*optionalVertexLine)[0];
 		edgeCount = (*optionalEdgeLine)[0];
+		dataStart = csvReader.tell();
 
 		initialized = true;
 	}
@@ -5,14 +5,20 @@
 #ifndef FRAMEWORK_BUFFERPOOL_H
 #define FRAMEWORK_BUFFERPOOL_H
 
+#include <cstdio>
 #include <functional>
-#include <list>
-#include <iterator>
+#include <vector>
+
+/*
+ * Both classes keep buffers in arrays of pointers - moving buffer between free and used ones doesn't allocate.
+ * For buffers paired with MPI requests see RequestPool, which checks only completed ones.
+ */
 
 template <class T>
 class AutoFreeingBuffer {
-	std::list<T*> freeBuffers;
-	std::list<T*> allocatedBuffers;
+	std::vector<T*> freeBuffers;
+	/* from the oldest one */
+	std::vector<T*> allocatedBuffers;
 
 	std::function<bool (T *)> softFreerer;
 	size_t softThreshold;
@@ -47,49 +53,53 @@ public:
 		if (freeBuffers.empty()) {
 			b = new T();
 		} else {
-			b = freeBuffers.front();
-			freeBuffers.pop_front();
+			b = freeBuffers.back();
+			freeBuffers.pop_back();
 		}
-		allocatedBuffers.push_front(b);
+		allocatedBuffers.push_back(b);
 		return b;
 	}
 
 	void tryFree() {
 		auto abs = allocatedBuffers.size();
 		if ((abs > hardThreshold)) {
-			auto it = allocatedBuffers.begin();
-			std::advance(it, abs - softThreshold);
-
+			/* oldest ones */
 			oneOffHardFreerer();
-			doIter(it, hardFreerer);
+			doIter(softThreshold, hardFreerer);
 		} else if (abs > softThreshold) {
-			doIter(allocatedBuffers.begin(), softFreerer);
+			doIter(abs, softFreerer);
 		}
 	}
 
 	void wait(bool hard = false) {
-		if (hard) doIter(allocatedBuffers.begin(), hardFreerer);
+		if (hard) doIter(allocatedBuffers.size(), hardFreerer);
 		else {
 			oneOffHardFreerer();
-			doIter(allocatedBuffers.begin(), softFreerer);
+			doIter(allocatedBuffers.size(), softFreerer);
 		}
 	}
 
+	~AutoFreeingBuffer() {
+		for(auto b: freeBuffers) delete b;
+	}
+
 private:
-	void doIter(typename std::list<T*>::iterator it, std::function<bool(T *)> freerer) {
-		while(it != allocatedBuffers.end()) {
-			if (freerer(*it)) {
+	/* tries to free first count buffers; remaining ones are compacted, so that they stay ordered by age */
+	void doIter(size_t count, const std::function<bool(T *)> &freerer) {
+		size_t kept = 0;
+		for(size_t i = 0; i < allocatedBuffers.size(); i++) {
+			T *b = allocatedBuffers[i];
+			if (i < count && freerer(b)) {
 				/* buffer has been freed */
 				if (freeBuffers.size() > softThreshold)
-					delete *it;
+					delete b;
 				else
-					freeBuffers.push_front(*it);
-
-				it = allocatedBuffers.erase(it);
+					freeBuffers.push_back(b);
 			} else {
-				it++;
+				allocatedBuffers[kept++] = b;
 			}
 		}
+		allocatedBuffers.resize(kept);
 	}
 
 };
@@ -98,8 +108,8 @@ private:
 
 template <class T> class BufferPool {
 private:
-	std::list<T*> freeBuffers;
-	std::list<T*> allocatedBuffers;
+	std::vector<T*> freeBuffers;
+	std::vector<T*> allocatedBuffers;
 
 public:
 	BufferPool(size_t initialSize = 0) {
@@ -120,7 +130,7 @@ public:
 	}
 
 	/**
-	 * Iterates over all free.
+	 * Iterates over all free (in unspecified order).
 	 * To singal that buffer is now used, return true.
 	 * Otherwise return false
 	 * @param f
@@ -130,7 +140,7 @@ public:
 	}
 
 	/**
-	 * Iterates over all used buffers.
+	 * Iterates over all used buffers (in unspecified order).
 	 * To singal that buffer has been freed, return true from f.
 	 * If you're still using the buffer, return false
 	 * @param f
@@ -140,22 +150,24 @@ public:
 	}
 
 private:
-	static void iterate(std::list<T*> &first,
-	                    std::list<T*> &second,
+	/* moved buffer is replaced with the last one, which is visited next */
+	static void iterate(std::vector<T*> &first,
+	                    std::vector<T*> &second,
 	                    const std::function<bool(T*)> &f) {
-		for (auto it = first.begin(); it != first.end();) {
-			if (f(*it)) {
-				second.push_front(*it);
-				it = first.erase(it);
+		for (size_t i = 0; i < first.size();) {
+			if (f(first[i])) {
+				second.push_back(first[i]);
+				first[i] = first.back();
+				first.pop_back();
 			} else {
-				it++;
+				i++;
 			}
 		}
 	}
 
 	void addEmptyBuffers(size_t count) {
-		for(int i = 0; i < count; i++) {
-			freeBuffers.push_front(new T);
+		for(size_t i = 0; i < count; i++) {
+			freeBuffers.push_back(new T);
 		}
 	}
 };
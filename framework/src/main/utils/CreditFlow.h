@@ -0,0 +1,158 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#ifndef FRAMEWORK_CREDITFLOW_H
+#define FRAMEWORK_CREDITFLOW_H
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <vector>
+#include <mpi.h>
+#include <glog/logging.h>
+#include <utils/Config.h>
+#include <utils/NonCopyable.h>
+
+namespace details { namespace FlowControl {
+	/* kB of messages a node can have waiting for it in MPI queues, split between all senders */
+	const std::string BUDGET_OPT = "fc-budget";
+	const size_t DEFAULT_BUDGET_KB = 16;
+	/* below that credits would be returned after almost every message */
+	const size_t MIN_CREDITS_PER_PEER = 16;
+}}
+
+/**
+ * Credit-based flow control of point-to-point messages (MPI_COMM_WORLD).
+ *
+ * Each node may have at most creditsPerPeer() messages sent to a given peer which that peer hasn't received yet - send
+ * takes a credit, which is given back by the receiver. Credits are returned in batches: piggybacked on messages going
+ * to the sender or, once half of them is held back, in explicit credits-only messages. This bounds the number of
+ * messages waiting for a node in MPI queues (and of sends in flight) by the budget. Messages that can't be sent yet are
+ * queued locally and posted by flush().
+ *
+ * TMessage must be default-constructible, have int fields sender & credits, isCreditsOnly() and setCreditsOnly()
+ * methods (the latter should also mark payload fields as invalid).
+ *
+ * Credits-only messages are not matched by any application message, so after the last one has been received
+ * finish() and polling receives until settled() make sure that none of them is left for the next user of the same
+ * communicator.
+ */
+template <typename TMessage>
+class CreditFlow : NonCopyable {
+public:
+	/* starts sending of message to peer, message must stay valid only during the call */
+	using Post = std::function<void(int, TMessage&)>;
+
+	CreditFlow(ConfigMap config, Post post) : post(post) {
+		using namespace details::FlowControl;
+
+		MPI_Comm_rank(MPI_COMM_WORLD, &nodeId);
+		MPI_Comm_size(MPI_COMM_WORLD, &nodeCount);
+
+		size_t budgetKb = DEFAULT_BUDGET_KB;
+		if (config.find(BUDGET_OPT) != config.end()) budgetKb = std::stoull(config[BUDGET_OPT]);
+		perPeer = std::max(MIN_CREDITS_PER_PEER, (budgetKb*1024)/sizeof(TMessage)/nodeCount);
+
+		credits.assign(nodeCount, static_cast<int>(perPeer));
+		owed.assign(nodeCount, 0);
+		pending.resize(nodeCount);
+		creditMessagesSent.assign(nodeCount, 0);
+	}
+
+	size_t creditsPerPeer() const {
+		return perPeer;
+	}
+
+	/* messages waiting for credits */
+	size_t pendingCount() const {
+		return pendingTotal;
+	}
+
+	void send(int peer, TMessage m) {
+		if (credits[peer] > 0 && pending[peer].empty()) {
+			postWithCredit(peer, m);
+		} else {
+			pending[peer].push_back(m);
+			pendingTotal++;
+		}
+	}
+
+	/* must be called for each received message; false if it carried only credits and shouldn't be processed further */
+	bool received(const TMessage& m) {
+		credits[m.sender] += m.credits;
+		if (m.isCreditsOnly()) {
+			creditMessagesReceived++;
+			return false;
+		}
+		owed[m.sender]++;
+		return true;
+	}
+
+	/* posts messages for which credits became available & returns credits held back for too long */
+	void flush() {
+		for(int peer = 0; peer < nodeCount; peer++) {
+			auto& queue = pending[peer];
+			while(!queue.empty() && credits[peer] > 0) {
+				postWithCredit(peer, queue.front());
+				queue.pop_front();
+				pendingTotal--;
+			}
+
+			if (static_cast<size_t>(owed[peer]) >= perPeer/2) {
+				/* value-initialized, so that no uninitialized bytes are sent */
+				TMessage m{};
+				m.setCreditsOnly();
+				m.sender = nodeId;
+				m.credits = owed[peer];
+				owed[peer] = 0;
+				post(peer, m);
+				creditMessagesSent[peer]++;
+			}
+		}
+	}
+
+	/* collective; called once all application messages destined for this node have been received */
+	void finish() {
+		if (pendingTotal > 0) LOG(WARNING) << pendingTotal << " messages still waiting for credits when finishing";
+
+		std::vector<int> expected(nodeCount, 0);
+		MPI_Alltoall(creditMessagesSent.data(), 1, MPI_INT, expected.data(), 1, MPI_INT, MPI_COMM_WORLD);
+		creditMessagesExpected = std::accumulate(expected.begin(), expected.end(), 0LL);
+	}
+
+	/* true once all credits-only messages sent to this node have been received (after finish()) */
+	bool settled() const {
+		return creditMessagesReceived >= creditMessagesExpected;
+	}
+
+private:
+	Post post;
+	int nodeId;
+	int nodeCount;
+	size_t perPeer;
+
+	/* credits this node may use to send to given peer */
+	std::vector<int> credits;
+	/* credits this node should give back to given peer */
+	std::vector<int> owed;
+	std::vector<std::deque<TMessage>> pending;
+	size_t pendingTotal = 0;
+
+	std::vector<int> creditMessagesSent;
+	long long creditMessagesReceived = 0;
+	long long creditMessagesExpected = 0;
+
+	void postWithCredit(int peer, TMessage& m) {
+		credits[peer]--;
+		m.sender = nodeId;
+		m.credits = owed[peer];
+		owed[peer] = 0;
+		post(peer, m);
+	}
+};
+
+#endif //FRAMEWORK_CREDITFLOW_H
@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 #include <fstream>
+#include <limits>
 #include <boost/optional.hpp>
 
 // details declarations
@@ -39,6 +40,34 @@ public:
 		}
 	}
 
+	/* positions are byte offsets from the beginning of the file */
+	std::streamoff tell() {
+		return ifs.tellg();
+	}
+
+	void seek(std::streamoff offset) {
+		ifs.clear();
+		ifs.seekg(offset);
+	}
+
+	std::streamoff size() {
+		auto current = ifs.tellg();
+		ifs.clear();
+		ifs.seekg(0, std::ifstream::end);
+		std::streamoff end = ifs.tellg();
+		ifs.seekg(current);
+		return end;
+	}
+
+	/* offset of the first line starting at or after given one (or size() if there is no such line) */
+	std::streamoff lineStartFrom(std::streamoff offset) {
+		if (offset <= 0) return 0;
+		seek(offset - 1);
+		ifs.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+		if (ifs.eof()) return size();
+		return ifs.tellg();
+	}
+
 private:
 	std::ifstream ifs;
 	std::string line;
@@ -0,0 +1,125 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#include "GraphGenerators.h"
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+
+namespace {
+	const double RMAT_A = 0.57;
+	const double RMAT_B = 0.19;
+	const double RMAT_C = 0.19;
+
+	/* splitmix64 - cheap, stateless, good enough for picking quadrants */
+	unsigned long long mix(unsigned long long x) {
+		x += 0x9E3779B97F4A7C15ULL;
+		x = (x ^ (x >> 30))*0xBF58476D1CE4E5B9ULL;
+		x = (x ^ (x >> 27))*0x94D049BB133111EBULL;
+		return x ^ (x >> 31);
+	}
+
+	/* draw-th random value for given edge */
+	unsigned long long randomBits(unsigned long long seed, unsigned long long edge, unsigned int draw) {
+		return mix(mix(seed ^ mix(edge)) + draw);
+	}
+
+	double uniform(unsigned long long seed, unsigned long long edge, unsigned int draw) {
+		return (randomBits(seed, edge, draw) >> 11)*(1.0/(1ULL << 53));
+	}
+
+	/* multiplication by odd number & xor are both bijections modulo 2^scale */
+	OriginalVertexId scramble(OriginalVertexId v, unsigned int scale, unsigned long long seed) {
+		const OriginalVertexId mask = (1ULL << scale) - 1;
+		v = (v*0x9E3779B97F4A7C15ULL) & mask;
+		v ^= mix(seed) & mask;
+		v = (v*0xD6E8FEB86659FD93ULL) & mask;
+		return v;
+	}
+}
+
+namespace GraphGenerators {
+
+Params Params::fromConfig(ConfigMap cm) {
+	Params p;
+	if (cm.find(SCALE_OPT) != cm.end()) p.scale = static_cast<unsigned int>(std::stoul(cm[SCALE_OPT]));
+	if (cm.find(EDGE_FACTOR_OPT) != cm.end()) p.edgeFactor = static_cast<unsigned int>(std::stoul(cm[EDGE_FACTOR_OPT]));
+	if (cm.find(SEED_OPT) != cm.end()) p.seed = std::stoull(cm[SEED_OPT]);
+	if (cm.find(EXPONENT_OPT) != cm.end()) p.exponent = std::stod(cm[EXPONENT_OPT]);
+
+	if (cm.find(KIND_OPT) != cm.end()) {
+		auto kind = cm[KIND_OPT];
+		if (kind == "rmat") p.kind = Kind::RMAT;
+		else if (kind == "er") p.kind = Kind::ER;
+		else if (kind == "powerlaw") p.kind = Kind::POWERLAW;
+		else throw std::runtime_error("Unknown generator: " + kind);
+	}
+
+	/* IndexPartitioner works on ints */
+	if (p.scale > 30)
+		throw std::runtime_error("Generated graphs are limited to scale 30");
+	if (p.kind == Kind::POWERLAW && p.exponent <= 1.0)
+		throw std::runtime_error("Power law exponent must be larger than 1");
+
+	return p;
+}
+
+std::string kindName(Kind kind) {
+	switch(kind) {
+		case Kind::RMAT: return "rmat";
+		case Kind::ER: return "er";
+		case Kind::POWERLAW: return "powerlaw";
+	}
+	return "";
+}
+
+void rmat(const Params& p, unsigned long long edgeFrom, unsigned long long edgeTo, std::vector<Edge>& out) {
+	for(auto e = edgeFrom; e < edgeTo; e++) {
+		OriginalVertexId u = 0, v = 0;
+		for(unsigned int level = 0; level < p.scale; level++) {
+			double r = uniform(p.seed, e, level);
+			OriginalVertexId uBit = (r >= RMAT_A + RMAT_B) ? 1 : 0;
+			OriginalVertexId vBit = ((r >= RMAT_A && r < RMAT_A + RMAT_B) || r >= RMAT_A + RMAT_B + RMAT_C) ? 1 : 0;
+			u = (u << 1) | uBit;
+			v = (v << 1) | vBit;
+		}
+		out.push_back(std::make_pair(scramble(u, p.scale, p.seed), scramble(v, p.scale, p.seed)));
+	}
+}
+
+void erdosRenyi(const Params& p, unsigned long long edgeFrom, unsigned long long edgeTo, std::vector<Edge>& out) {
+	const OriginalVertexId mask = p.vertexCount() - 1;
+	for(auto e = edgeFrom; e < edgeTo; e++) {
+		out.push_back(std::make_pair(randomBits(p.seed, e, 0) & mask, randomBits(p.seed, e, 1) & mask));
+	}
+}
+
+void powerLaw(const Params& p, unsigned long long edgeFrom, unsigned long long edgeTo, std::vector<Edge>& out) {
+	/* inverse of (continuous approximation of) CDF of weights x^(-alpha) over [1, n+1) */
+	const double n = static_cast<double>(p.vertexCount());
+	const double alpha = 1.0/(p.exponent - 1.0);
+	const double oneMinusAlpha = 1.0 - alpha;
+	const double upper = (std::fabs(oneMinusAlpha) < 1e-9) ? std::log(n + 1.0) : std::pow(n + 1.0, oneMinusAlpha) - 1.0;
+
+	auto draw = [&](unsigned long long e, unsigned int which) {
+		double u = uniform(p.seed, e, which);
+		double x = (std::fabs(oneMinusAlpha) < 1e-9) ? std::exp(u*upper) : std::pow(1.0 + u*upper, 1.0/oneMinusAlpha);
+		auto id = static_cast<OriginalVertexId>(x) - 1;
+		return std::min(id, p.vertexCount() - 1);
+	};
+
+	for(auto e = edgeFrom; e < edgeTo; e++) {
+		out.push_back(std::make_pair(scramble(draw(e, 0), p.scale, p.seed), scramble(draw(e, 1), p.scale, p.seed)));
+	}
+}
+
+void generate(const Params& p, unsigned long long edgeFrom, unsigned long long edgeTo, std::vector<Edge>& out) {
+	switch(p.kind) {
+		case Kind::RMAT: rmat(p, edgeFrom, edgeTo, out); break;
+		case Kind::ER: erdosRenyi(p, edgeFrom, edgeTo, out); break;
+		case Kind::POWERLAW: powerLaw(p, edgeFrom, edgeTo, out); break;
+	}
+}
+
+}
@@ -0,0 +1,73 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#ifndef FRAMEWORK_GRAPHGENERATORS_H
+#define FRAMEWORK_GRAPHGENERATORS_H
+
+#include <vector>
+#include <utility>
+#include <string>
+#include <Prerequisites.h>
+#include <utils/Config.h>
+
+/**
+ * Edge generators for graphs built in memory (without going through a file).
+ *
+ * Every edge is generated from (seed, edge index) only, so any node can produce any slice of the edge list and
+ * the graph does not depend on number of nodes generating it.
+ */
+namespace GraphGenerators {
+	using Edge = std::pair<OriginalVertexId, OriginalVertexId>;
+
+	enum class Kind {RMAT, ER, POWERLAW};
+
+	/* rmat, er or powerlaw */
+	const std::string KIND_OPT = "gen";
+	const std::string SCALE_OPT = "gen-scale";
+	const std::string EDGE_FACTOR_OPT = "gen-ef";
+	const std::string SEED_OPT = "gen-seed";
+	const std::string EXPONENT_OPT = "gen-exp";
+
+	struct Params {
+		Kind kind = Kind::RMAT;
+		/* graph has 2^scale vertices ... */
+		unsigned int scale = 10;
+		/* ... and edgeFactor*2^scale (undirected, before removal of loops & duplicates) edges */
+		unsigned int edgeFactor = 16;
+		unsigned long long seed = 1;
+		/* exponent of degree distribution, used only by POWERLAW */
+		double exponent = 2.5;
+
+		OriginalVertexId vertexCount() const { return 1ULL << scale; }
+		unsigned long long edgeCount() const { return edgeFactor*vertexCount(); }
+
+		/* values not present in the map are left with defaults */
+		static Params fromConfig(ConfigMap cm);
+	};
+
+	/* as accepted by KIND_OPT */
+	std::string kindName(Kind kind);
+
+	/**
+	 * R-MAT/Kronecker with Graph500 initiator (A = 0.57, B = C = 0.19). Vertex ids are scrambled, so that
+	 * high degree vertices are not clustered at the beginning of id space.
+	 *
+	 * Appends edges [edgeFrom, edgeTo) to out
+	 */
+	void rmat(const Params& p, unsigned long long edgeFrom, unsigned long long edgeTo, std::vector<Edge>& out);
+
+	/* Erdos-Renyi G(n, m) - both ends of each edge are chosen uniformly */
+	void erdosRenyi(const Params& p, unsigned long long edgeFrom, unsigned long long edgeTo, std::vector<Edge>& out);
+
+	/**
+	 * Chung-Lu graph with expected degrees following power law with given exponent: ends of each edge are drawn
+	 * with probability proportional to vertex weight (i+1)^(-1/(exponent-1)). Ids are scrambled, as in rmat.
+	 */
+	void powerLaw(const Params& p, unsigned long long edgeFrom, unsigned long long edgeTo, std::vector<Edge>& out);
+
+	/* dispatches on p.kind */
+	void generate(const Params& p, unsigned long long edgeFrom, unsigned long long edgeTo, std::vector<Edge>& out);
+}
+
+#endif //FRAMEWORK_GRAPHGENERATORS_H
@@ -30,4 +30,26 @@ std::pair<int, int> get_range_for_partition(int element_count, int partition_cou
 	return std::make_pair(start, start + count);
 }
 
+PartitionTable::PartitionTable(int element_count, int partition_count) : shift(0) {
+	starts.resize(partition_count + 1);
+	for(int i = 0; i < partition_count; i++) {
+		starts[i] = get_range_for_partition(element_count, partition_count, i).first;
+	}
+	starts[partition_count] = element_count;
+
+	/* narrowest partition is base_width wide (or empty, if there are more partitions than elements - then buckets have
+	 * single element and skipping empty partitions below still gives the right one) */
+	int base_width = element_count / partition_count;
+	while((2 << shift) <= base_width) shift++;
+
+	int bucketCount = (element_count >> shift) + 1;
+	bucketFirstPartition.resize(bucketCount);
+	int p = 0;
+	for(int b = 0; b < bucketCount; b++) {
+		int bucketStart = b << shift;
+		while(p + 1 < partition_count && starts[p + 1] <= bucketStart) p++;
+		bucketFirstPartition[b] = p;
+	}
+}
+
 }
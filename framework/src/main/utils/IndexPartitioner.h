@@ -6,6 +6,7 @@
 #define FRAMEWORK_INDEXPARTITIONER_H
 
 #include <utility>
+#include <vector>
 
 namespace IndexPartitioner {
 
@@ -19,6 +20,46 @@ int get_partition_from_index(int element_count, int partition_count, int index);
  */
 std::pair <int, int> get_range_for_partition(int element_count, int partition_count, int partition_no);
 
+/**
+ * The same partitioning as above, precomputed for lookups on hot paths (every edge endpoint), which otherwise cost
+ * several divisions each.
+ *
+ * Start of partition is read from a table. Partition of an index is found in a table of buckets of 2^shift indices,
+ * where bucket is never wider than the narrowest partition - so it spans at most two partitions and one comparison
+ * decides between them.
+ */
+class PartitionTable {
+public:
+	PartitionTable(int element_count = 0, int partition_count = 1);
+
+	int partitionStart(int partition_no) const {
+		return starts[partition_no];
+	}
+
+	std::pair<int, int> range(int partition_no) const {
+		return std::make_pair(starts[partition_no], starts[partition_no + 1]);
+	}
+
+	int partitionOf(int index) const {
+		int p = bucketFirstPartition[index >> shift];
+		return (index >= starts[p + 1]) ? p + 1 : p;
+	}
+
+	int getElementCount() const {
+		return starts.back();
+	}
+
+	int getPartitionCount() const {
+		return static_cast<int>(starts.size()) - 1;
+	}
+
+private:
+	/* partition_count + 1 entries, last one is element_count */
+	std::vector<int> starts;
+	std::vector<int> bucketFirstPartition;
+	int shift;
+};
+
 }
 
 #endif //FRAMEWORK_INDEXPARTITIONER_H
@@ -13,6 +13,9 @@ TypeMap mapWithCommonTypes() {
 	m.emplace(typeid(unsigned short), MPI_UNSIGNED_SHORT);
 	m.emplace(typeid(int), MPI_INT);
 	m.emplace(typeid(unsigned int), MPI_UNSIGNED);
+	/* int64_t/uint64_t and size_t on LP64 */
+	m.emplace(typeid(long), MPI_LONG);
+	m.emplace(typeid(unsigned long), MPI_UNSIGNED_LONG);
 	m.emplace(typeid(long long), MPI_LONG_LONG_INT);
 	m.emplace(typeid(unsigned long long), MPI_UNSIGNED_LONG_LONG);
 
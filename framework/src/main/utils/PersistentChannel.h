@@ -0,0 +1,90 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#ifndef FRAMEWORK_PERSISTENTCHANNEL_H
+#define FRAMEWORK_PERSISTENTCHANNEL_H
+
+#include <vector>
+#include <mpi.h>
+#include <utils/NonCopyable.h>
+
+/**
+ * Exchange of fixed-size messages (count elements of datatype) between every pair of ranks of the communicator, repeated
+ * in rounds - e.g. once per BFS level.
+ *
+ * Send & receive requests to all peers are created once with MPI_Send_init/MPI_Recv_init over buffers owned by the
+ * channel and each round is only started with MPI_Startall, so per-round setup doesn't depend on the number of
+ * peers. Messages of consecutive rounds are matched in order (same source & tag), so peer may start the next round
+ * before this one has finished.
+ *
+ * Datatype must remain valid until the channel is destroyed.
+ */
+template <typename T>
+class PersistentChannel : NonCopyable {
+public:
+	PersistentChannel(MPI_Datatype datatype, int tag, int count = 1, MPI_Comm comm = MPI_COMM_WORLD) : count(count) {
+		MPI_Comm_size(comm, &worldSize);
+		sendBuffers.resize(static_cast<size_t>(worldSize*count));
+		receiveBuffers.resize(static_cast<size_t>(worldSize*count));
+		requests.resize(static_cast<size_t>(2*worldSize));
+		completedIndices.resize(static_cast<size_t>(worldSize));
+
+		/* receives first, so that they can be started together */
+		for(int i = 0; i < worldSize; i++) {
+			MPI_Recv_init(receiveBuffer(i), count, datatype, i, tag, comm, requests.data() + i);
+			MPI_Send_init(sendBuffer(i), count, datatype, i, tag, comm, requests.data() + worldSize + i);
+		}
+	}
+
+	~PersistentChannel() {
+		for(auto& rq: requests) MPI_Request_free(&rq);
+	}
+
+	/* contents are sent at the next start(); must not be modified until the round finishes */
+	T* sendBuffer(int peer) {
+		return sendBuffers.data() + peer*count;
+	}
+
+	/* valid after message from given peer has been passed to onReceived */
+	T* receiveBuffer(int peer) {
+		return receiveBuffers.data() + peer*count;
+	}
+
+	/**
+	 * Runs whole round: starts all requests, calls onReceived(peer, T* message) for every peer in order of arrival
+	 * and waits until all sends complete.
+	 */
+	template <typename F>
+	void exchange(F onReceived) {
+		MPI_Startall(static_cast<int>(requests.size()), requests.data());
+
+		int completed = 0;
+		while(completed < worldSize) {
+			int completedInThisIt = 0;
+			MPI_Waitsome(worldSize, requests.data(), &completedInThisIt, completedIndices.data(), MPI_STATUSES_IGNORE);
+			for(int i = 0; i < completedInThisIt; i++) {
+				auto peer = completedIndices[i];
+				onReceived(peer, receiveBuffer(peer));
+			}
+			completed += completedInThisIt;
+		}
+
+		MPI_Waitall(worldSize, requests.data() + worldSize, MPI_STATUSES_IGNORE);
+	}
+
+	int getWorldSize() const {
+		return worldSize;
+	}
+
+private:
+	int count;
+	int worldSize;
+	std::vector<T> sendBuffers;
+	std::vector<T> receiveBuffers;
+	/* receives, then sends */
+	std::vector<MPI_Request> requests;
+	std::vector<int> completedIndices;
+};
+
+#endif //FRAMEWORK_PERSISTENTCHANNEL_H
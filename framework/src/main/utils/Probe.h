@@ -16,25 +16,27 @@ public:
 
 	void start() {
 		assert(!started);
-		startTimePoint = std::chrono::system_clock::now();
+		startTimePoint = std::chrono::steady_clock::now();
 		started = true;
 	};
 
-	void stop() {
+	/* returns measured time, so that callers can aggregate it */
+	std::chrono::nanoseconds stop() {
 		assert(started);
-		auto duration = std::chrono::system_clock::now() - startTimePoint;
+		auto duration = std::chrono::steady_clock::now() - startTimePoint;
 		auto durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(duration);
 		std::string probeType = global ? "TG" : "TL";
 
 		/* time is reported in nanoseconds */
 		LOG(WARNING) << "[P:" << probeType << ":" << name << ":" << durationNs.count() << "]";
+		return durationNs;
 	}
 
 private:
 	std::string name;
 	bool started;
 	bool global;
-	std::chrono::system_clock::time_point startTimePoint;
+	std::chrono::steady_clock::time_point startTimePoint;
 };
 
 
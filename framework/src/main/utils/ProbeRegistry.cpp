@@ -0,0 +1,209 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#include "ProbeRegistry.h"
+#include <fstream>
+#include <iomanip>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <glog/logging.h>
+
+namespace {
+	const char TIMER_KEY = 't';
+	const char COUNTER_KEY = 'c';
+
+	/* union of keys from all ranks, so that every rank reduces the same vector in the same order */
+	std::vector<std::string> gatherKeys(const std::vector<std::string>& localKeys, MPI_Comm comm) {
+		std::string joined;
+		for(auto& k: localKeys) {
+			joined += k;
+			joined += '\n';
+		}
+
+		int size;
+		MPI_Comm_size(comm, &size);
+		int localLength = static_cast<int>(joined.size());
+		std::vector<int> lengths(size), displs(size);
+		MPI_Allgather(&localLength, 1, MPI_INT, lengths.data(), 1, MPI_INT, comm);
+		int total = 0;
+		for(int i = 0; i < size; i++) {
+			displs[i] = total;
+			total += lengths[i];
+		}
+
+		std::vector<char> all(static_cast<size_t>(total));
+		MPI_Allgatherv(joined.data(), localLength, MPI_CHAR, all.data(), lengths.data(), displs.data(), MPI_CHAR, comm);
+
+		std::set<std::string> keys;
+		std::stringstream ss(std::string(all.begin(), all.end()));
+		std::string key;
+		while(std::getline(ss, key)) keys.insert(key);
+		return std::vector<std::string>(keys.begin(), keys.end());
+	}
+
+	std::string escape(const std::string& s) {
+		std::string escaped;
+		for(auto c: s) {
+			if (c == '"' || c == '\\') escaped += '\\';
+			escaped += c;
+		}
+		return escaped;
+	}
+
+	void writeSection(std::ostream& os, const std::string& name, const std::map<std::string, ReducedValue>& values,
+	                  bool last) {
+		os << "  \"" << name << "\": {";
+		bool first = true;
+		for(auto& p: values) {
+			os << (first ? "\n" : ",\n");
+			os << "    \"" << escape(p.first) << "\": {\"min\": " << p.second.min << ", \"max\": " << p.second.max
+			   << ", \"avg\": " << p.second.avg << ", \"sum\": " << p.second.sum << "}";
+			first = false;
+		}
+		os << (first ? "}" : "\n  }") << (last ? "\n" : ",\n");
+	}
+}
+
+ProbeRegistry& ProbeRegistry::instance() {
+	static ProbeRegistry registry;
+	return registry;
+}
+
+std::string ProbeRegistry::pathFor(const std::string& name) const {
+	return open.empty() ? name : open.back().path + "/" + name;
+}
+
+const std::string& ProbeRegistry::currentPhase() const {
+	static const std::string noPhase;
+	return open.empty() ? noPhase : open.front().path;
+}
+
+void ProbeRegistry::enter(const std::string& name) {
+	OpenScope scope;
+	scope.path = pathFor(name);
+	scope.start = std::chrono::steady_clock::now();
+	open.push_back(scope);
+}
+
+void ProbeRegistry::leave() {
+	if (open.empty())
+		throw std::runtime_error("ProbeRegistry: leave() without matching enter()");
+
+	auto& scope = open.back();
+	auto& timer = timers[scope.path];
+	timer.total += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - scope.start);
+	timer.calls += 1;
+	open.pop_back();
+}
+
+ScopedProbe::~ScopedProbe() noexcept {
+	try {
+		ProbeRegistry::instance().leave();
+	} catch (const std::exception& e) {
+		LOG(ERROR) << e.what();
+	}
+}
+
+void ProbeRegistry::count(const std::string& name, unsigned long long value) {
+	counters[pathFor(name)] += value;
+}
+
+void ProbeRegistry::reset() {
+	if (!open.empty())
+		throw std::runtime_error("ProbeRegistry: reset() with open scopes");
+
+	timers.clear();
+	counters.clear();
+}
+
+ReducedProbes ProbeRegistry::reduce(MPI_Comm comm) const {
+	std::vector<std::string> localKeys;
+	for(auto& p: timers) localKeys.push_back(TIMER_KEY + p.first);
+	for(auto& p: counters) localKeys.push_back(COUNTER_KEY + p.first);
+	auto keys = gatherKeys(localKeys, comm);
+
+	/* timers contribute two values (seconds & calls), counters - one */
+	std::vector<double> local;
+	for(auto& k: keys) {
+		auto path = k.substr(1);
+		if (k[0] == TIMER_KEY) {
+			auto it = timers.find(path);
+			bool present = it != timers.end();
+			local.push_back(present ? std::chrono::duration<double>(it->second.total).count() : 0.0);
+			local.push_back(present ? static_cast<double>(it->second.calls) : 0.0);
+		} else {
+			auto it = counters.find(path);
+			local.push_back(it != counters.end() ? static_cast<double>(it->second) : 0.0);
+		}
+	}
+
+	int n = static_cast<int>(local.size());
+	std::vector<double> mins(local.size()), maxs(local.size()), sums(local.size());
+	MPI_Allreduce(local.data(), mins.data(), n, MPI_DOUBLE, MPI_MIN, comm);
+	MPI_Allreduce(local.data(), maxs.data(), n, MPI_DOUBLE, MPI_MAX, comm);
+	MPI_Allreduce(local.data(), sums.data(), n, MPI_DOUBLE, MPI_SUM, comm);
+
+	ReducedProbes reduced;
+	MPI_Comm_size(comm, &reduced.ranks);
+	auto valueAt = [&](size_t i) {
+		ReducedValue v;
+		v.min = mins[i];
+		v.max = maxs[i];
+		v.sum = sums[i];
+		v.avg = sums[i]/reduced.ranks;
+		return v;
+	};
+
+	size_t i = 0;
+	for(auto& k: keys) {
+		auto path = k.substr(1);
+		if (k[0] == TIMER_KEY) {
+			reduced.timerSeconds[path] = valueAt(i++);
+			reduced.timerCalls[path] = valueAt(i++);
+		} else {
+			reduced.counters[path] = valueAt(i++);
+		}
+	}
+
+	return reduced;
+}
+
+void ProbeRegistry::report(const std::string& jsonPath, MPI_Comm comm) const {
+	auto reduced = reduce(comm);
+
+	int rank;
+	MPI_Comm_rank(comm, &rank);
+	if (rank != 0) return;
+
+	for(auto& p: reduced.timerSeconds) {
+		LOG(INFO) << "Probe " << p.first << " [s] min: " << p.second.min << " max: " << p.second.max
+		          << " avg: " << p.second.avg << " (calls: " << reduced.timerCalls.at(p.first).max << ")";
+	}
+	for(auto& p: reduced.counters) {
+		LOG(INFO) << "Counter " << p.first << " min: " << p.second.min << " max: " << p.second.max
+		          << " avg: " << p.second.avg << " sum: " << p.second.sum;
+	}
+
+	if (!jsonPath.empty()) {
+		std::ofstream out(jsonPath);
+		if (!out) {
+			LOG(ERROR) << "Cannot write probes to " << jsonPath;
+			return;
+		}
+		out << toJson(reduced);
+		LOG(INFO) << "Probes written to " << jsonPath;
+	}
+}
+
+std::string ProbeRegistry::toJson(const ReducedProbes& reduced) {
+	std::stringstream os;
+	os << std::setprecision(17);
+	os << "{\n  \"ranks\": " << reduced.ranks << ",\n";
+	writeSection(os, "timers_seconds", reduced.timerSeconds, false);
+	writeSection(os, "timer_calls", reduced.timerCalls, false);
+	writeSection(os, "counters", reduced.counters, true);
+	os << "}\n";
+	return os.str();
+}
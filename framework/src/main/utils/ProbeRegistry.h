@@ -0,0 +1,91 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#ifndef FRAMEWORK_PROBEREGISTRY_H
+#define FRAMEWORK_PROBEREGISTRY_H
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+#include <mpi.h>
+#include <utils/NonCopyable.h>
+
+namespace details { namespace Probes {
+	/* path of the file to which reduced probes are written (by rank 0) */
+	const std::string JSON_OUTPUT_OPT = "probes-json";
+}}
+
+/* statistics of a single value across ranks (ranks which never touched it contribute 0) */
+struct ReducedValue {
+	double min = 0.0;
+	double max = 0.0;
+	double avg = 0.0;
+	double sum = 0.0;
+};
+
+struct ReducedProbes {
+	int ranks = 0;
+	std::map<std::string, ReducedValue> timerSeconds;
+	std::map<std::string, ReducedValue> timerCalls;
+	std::map<std::string, ReducedValue> counters;
+};
+
+/**
+ * Per-process registry of hierarchical timers and counters.
+ *
+ * Scopes nest: entering "level" inside "Algorithm" accumulates time under "Algorithm/level". Repeated entries of the
+ * same scope (e.g. one per BFS level) are summed and counted. Counters are attributed to the innermost open scope.
+ *
+ * Unlike Probe, nothing is logged while measuring - report() reduces everything across ranks at the end of the run.
+ */
+class ProbeRegistry : NonCopyable {
+public:
+	struct Timer {
+		std::chrono::nanoseconds total = std::chrono::nanoseconds::zero();
+		unsigned long long calls = 0;
+	};
+
+	static ProbeRegistry& instance();
+
+	void enter(const std::string& name);
+	void leave();
+	void count(const std::string& name, unsigned long long value);
+	/* drops all measurements; must not be called with scopes open */
+	void reset();
+
+	/* outermost open scope (e.g. "Algorithm"), empty if there is none */
+	const std::string& currentPhase() const;
+
+	const std::map<std::string, Timer>& getTimers() const { return timers; }
+	const std::map<std::string, unsigned long long>& getCounters() const { return counters; }
+
+	/* collective - every rank gets the same result */
+	ReducedProbes reduce(MPI_Comm comm = MPI_COMM_WORLD) const;
+	/* collective - rank 0 logs the summary and, if path is not empty, writes it as JSON */
+	void report(const std::string& jsonPath, MPI_Comm comm = MPI_COMM_WORLD) const;
+
+	static std::string toJson(const ReducedProbes& reduced);
+
+private:
+	struct OpenScope {
+		std::string path;
+		std::chrono::steady_clock::time_point start;
+	};
+
+	std::vector<OpenScope> open;
+	std::map<std::string, Timer> timers;
+	std::map<std::string, unsigned long long> counters;
+
+	std::string pathFor(const std::string& name) const;
+};
+
+/* RAII helper for ProbeRegistry scopes; unbalanced leave is only logged, as destructor must not throw */
+class ScopedProbe : NonCopyable {
+public:
+	ScopedProbe(const std::string& name) { ProbeRegistry::instance().enter(name); }
+	~ScopedProbe() noexcept;
+};
+
+#endif //FRAMEWORK_PROBEREGISTRY_H
@@ -0,0 +1,141 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#ifndef FRAMEWORK_REQUESTPOOL_H
+#define FRAMEWORK_REQUESTPOOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <vector>
+#include <mpi.h>
+#include <glog/logging.h>
+#include <utils/NonCopyable.h>
+
+/**
+ * Buffers used by non-blocking MPI operations, each paired with its request.
+ *
+ * Buffers are allocated from a slab (they never move, so pointers remain valid), free ones are kept on an array-backed
+ * stack and requests of the ones in flight in a contiguous array. Completion is checked with a single
+ * MPI_Testsome/MPI_Waitsome, so recycling costs O(completed) instead of O(in flight) and moving buffer between free
+ * and in-flight state doesn't allocate. Order of in-flight buffers isn't preserved.
+ */
+template <typename T>
+class RequestPool : NonCopyable {
+public:
+	RequestPool(size_t initialCapacity = 0) {
+		for(size_t i = 0; i < initialCapacity; i++) freeBuffers.push_back(allocate());
+	}
+
+	~RequestPool() {
+		if (!requests.empty())
+			LOG(WARNING) << requests.size() << " requests still in flight when destroying RequestPool";
+	}
+
+	/* buffer that isn't in flight; allocated if there are no free ones */
+	T* get() {
+		if (freeBuffers.empty()) return allocate();
+		T* b = freeBuffers.back();
+		freeBuffers.pop_back();
+		return b;
+	}
+
+	/* buffer obtained from get() becomes in flight; rq is the request of operation started on it */
+	void submit(T* b, MPI_Request rq) {
+		requests.push_back(rq);
+		inFlightBuffers.push_back(b);
+	}
+
+	size_t inFlight() const {
+		return requests.size();
+	}
+
+	/**
+	 * Each completed buffer is passed to onCompleted(T*, MPI_Request&). If callback starts new operation on that buffer
+	 * (storing its request in the reference) and returns true, buffer stays in flight - otherwise it becomes free.
+	 *
+	 * @return number of completed requests
+	 */
+	template <typename F>
+	size_t testSome(F onCompleted) {
+		if (requests.empty()) return 0;
+		indices.resize(requests.size());
+		int outCount = 0;
+		MPI_Testsome(static_cast<int>(requests.size()), requests.data(), &outCount, indices.data(), MPI_STATUSES_IGNORE);
+		return processCompleted(outCount, onCompleted);
+	}
+
+	size_t testSome() {
+		return testSome(releaseCompleted);
+	}
+
+	/* like testSome, but blocks until at least one request completes (unless there are none in flight) */
+	template <typename F>
+	size_t waitSome(F onCompleted) {
+		if (requests.empty()) return 0;
+		indices.resize(requests.size());
+		int outCount = 0;
+		MPI_Waitsome(static_cast<int>(requests.size()), requests.data(), &outCount, indices.data(), MPI_STATUSES_IGNORE);
+		return processCompleted(outCount, onCompleted);
+	}
+
+	size_t waitSome() {
+		return waitSome(releaseCompleted);
+	}
+
+	/* waits for all requests in flight, all buffers become free */
+	void waitAll() {
+		MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+		freeBuffers.insert(freeBuffers.end(), inFlightBuffers.begin(), inFlightBuffers.end());
+		requests.clear();
+		inFlightBuffers.clear();
+	}
+
+	/* for operations that may never complete, e.g. receives posted in advance */
+	void cancelAll() {
+		for(auto& rq: requests) MPI_Cancel(&rq);
+		waitAll();
+	}
+
+private:
+	std::deque<T> slab;
+	std::vector<T*> freeBuffers;
+	std::vector<MPI_Request> requests;
+	std::vector<T*> inFlightBuffers;
+	std::vector<int> indices;
+
+	static bool releaseCompleted(T*, MPI_Request&) {
+		return false;
+	}
+
+	T* allocate() {
+		slab.emplace_back();
+		return &slab.back();
+	}
+
+	template <typename F>
+	size_t processCompleted(int outCount, F& onCompleted) {
+		if (outCount == MPI_UNDEFINED || outCount <= 0) return 0;
+		auto count = static_cast<size_t>(outCount);
+
+		/* completed ones are replaced by the last one, so going from the highest index only moves unprocessed requests */
+		std::sort(indices.begin(), indices.begin() + count, std::greater<int>());
+		for(size_t k = 0; k < count; k++) {
+			auto i = static_cast<size_t>(indices[k]);
+			T* b = inFlightBuffers[i];
+			if (onCompleted(b, requests[i])) continue;
+
+			freeBuffers.push_back(b);
+			requests[i] = requests.back();
+			requests.pop_back();
+			inFlightBuffers[i] = inFlightBuffers.back();
+			inFlightBuffers.pop_back();
+		}
+
+		return count;
+	}
+};
+
+#endif //FRAMEWORK_REQUESTPOOL_H
@@ -0,0 +1,75 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#ifndef FRAMEWORK_ROOTSAMPLING_H
+#define FRAMEWORK_ROOTSAMPLING_H
+
+#include <algorithm>
+#include <random>
+#include <unordered_set>
+#include <vector>
+#include <mpi.h>
+#include <glog/logging.h>
+#include <GraphPartition.h>
+
+namespace RootSampling {
+	/**
+	 * Draws (with the same seed on every node) roots from the global sequence of non-isolated masters, ordered by
+	 * node; owner of each root broadcasts its GlobalId. Returns fewer roots if there aren't enough candidates.
+	 *
+	 * Collective (MPI_COMM_WORLD).
+	 */
+	template <typename G>
+	std::vector<typename G::GidType> nonIsolated(G& g, size_t count, unsigned long long seed) {
+		IMPORT_ALIASES(G)
+
+		int worldSize;
+		MPI_Comm_size(MPI_COMM_WORLD, &worldSize);
+		int rank;
+		MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+		std::vector<LocalId> candidates;
+		g.foreachMasterVertex([&](const LocalId vid) {
+			bool hasNeighbours = false;
+			g.foreachNeighbouringVertex(vid, [&](const GlobalId) {
+				hasNeighbours = true;
+				return ITER_PROGRESS::STOP;
+			});
+			if (hasNeighbours) candidates.push_back(vid);
+			return ITER_PROGRESS::CONTINUE;
+		});
+
+		unsigned long long localCount = candidates.size();
+		std::vector<unsigned long long> counts(worldSize);
+		MPI_Allgather(&localCount, 1, MPI_UNSIGNED_LONG_LONG, counts.data(), 1, MPI_UNSIGNED_LONG_LONG, MPI_COMM_WORLD);
+		std::vector<unsigned long long> offsets(worldSize + 1, 0);
+		for(int i = 0; i < worldSize; i++) offsets[i+1] = offsets[i] + counts[i];
+		auto total = offsets[worldSize];
+
+		if (count > total) {
+			LOG(WARNING) << "Only " << total << " non-isolated vertices, using all of them as roots";
+			count = total;
+		}
+
+		std::mt19937_64 rng(seed);
+		std::uniform_int_distribution<unsigned long long> dist(0, total > 0 ? total - 1 : 0);
+		std::unordered_set<unsigned long long> drawn;
+		std::vector<GlobalId> roots;
+		auto gidDt = g.getGlobalVertexIdDatatype();
+		while(roots.size() < count) {
+			auto idx = dist(rng);
+			if (!drawn.insert(idx).second) continue;
+
+			int owner = static_cast<int>(std::upper_bound(offsets.begin(), offsets.end(), idx) - offsets.begin()) - 1;
+			GlobalId root;
+			if (owner == rank) root = g.toGlobalId(candidates[idx - offsets[rank]]);
+			MPI_Bcast(&root, 1, gidDt, owner, MPI_COMM_WORLD);
+			roots.push_back(root);
+		}
+
+		return roots;
+	}
+}
+
+#endif //FRAMEWORK_ROOTSAMPLING_H
@@ -0,0 +1,112 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#ifndef FRAMEWORK_SHAREDARRAY_H
+#define FRAMEWORK_SHAREDARRAY_H
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <mpi.h>
+#include <glog/logging.h>
+#include <utils/Config.h>
+#include <utils/NonCopyable.h>
+
+namespace details { namespace SharedMemory {
+	/* 1 - ranks running on the same host access each other's per-vertex state directly instead of through MPI */
+	const std::string ENABLED_OPT = "shm";
+
+	inline bool enabledInConfig(ConfigMap cm) {
+		auto it = cm.find(ENABLED_OPT);
+		return it != cm.end() && it->second == "1";
+	}
+}}
+
+/**
+ * Per-rank array of count elements, placed in memory shared by all ranks of the same host (MPI_COMM_WORLD split with
+ * MPI_COMM_TYPE_SHARED, window from MPI_Win_allocate_shared). Each rank writes its own segment, ranks on the same host
+ * can read it through segmentOf() after publish(). Segments of other ranks may also be updated (with atomic
+ * operations), such updates are visible to the owner after the next publish().
+ *
+ * Construction, publish() and destruction are collective operations (MPI_COMM_WORLD for construction, host
+ * communicator for the rest).
+ */
+template <typename T>
+class SharedArray : NonCopyable {
+public:
+	SharedArray(size_t count) {
+		int worldRank, worldSize, hostSize;
+		MPI_Comm_rank(MPI_COMM_WORLD, &worldRank);
+		MPI_Comm_size(MPI_COMM_WORLD, &worldSize);
+		MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, worldRank, MPI_INFO_NULL, &hostComm);
+		MPI_Comm_size(hostComm, &hostSize);
+
+		/* at least one element, so that every rank gets a distinct address */
+		MPI_Win_allocate_shared(std::max(count, static_cast<size_t>(1))*sizeof(T), sizeof(T), MPI_INFO_NULL, hostComm,
+		                        &localSegment, &win);
+		MPI_Win_lock_all(MPI_MODE_NOCHECK, win);
+
+		/* world rank -> segment, for ranks on this host */
+		std::vector<int> hostRanks(hostSize), worldRanks(hostSize);
+		for(int i = 0; i < hostSize; i++) hostRanks[i] = i;
+		MPI_Group worldGroup, hostGroup;
+		MPI_Comm_group(MPI_COMM_WORLD, &worldGroup);
+		MPI_Comm_group(hostComm, &hostGroup);
+		MPI_Group_translate_ranks(hostGroup, hostSize, hostRanks.data(), worldGroup, worldRanks.data());
+		MPI_Group_free(&hostGroup);
+		MPI_Group_free(&worldGroup);
+
+		segments.assign(worldSize, nullptr);
+		for(int i = 0; i < hostSize; i++) {
+			MPI_Aint size;
+			int dispUnit;
+			T* base;
+			MPI_Win_shared_query(win, i, &size, &dispUnit, &base);
+			segments[worldRanks[i]] = base;
+		}
+
+		VLOG(1) << "Shared array of " << count << " elements, " << hostSize << " ranks on this host";
+	}
+
+	~SharedArray() {
+		MPI_Win_unlock_all(win);
+		MPI_Win_free(&win);
+		MPI_Comm_free(&hostComm);
+	}
+
+	/* segment of this rank */
+	T* data() {
+		return localSegment;
+	}
+
+	/* segment of given rank (of MPI_COMM_WORLD) or nullptr if it runs on another host */
+	const T* segmentOf(int worldRank) const {
+		return segments[worldRank];
+	}
+
+	/* as above, but for updating other rank's segment - concurrent writers must use atomic operations */
+	T* segmentOf(int worldRank) {
+		return segments[worldRank];
+	}
+
+	bool onThisHost(int worldRank) const {
+		return segments[worldRank] != nullptr;
+	}
+
+	/* makes writes to own segment visible to all ranks of this host */
+	void publish() {
+		MPI_Win_sync(win);
+		MPI_Barrier(hostComm);
+		MPI_Win_sync(win);
+	}
+
+private:
+	MPI_Comm hostComm;
+	MPI_Win win;
+	T* localSegment;
+	std::vector<T*> segments;
+};
+
+#endif //FRAMEWORK_SHAREDARRAY_H
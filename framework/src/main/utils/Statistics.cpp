@@ -0,0 +1,62 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#include "Statistics.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	double quantile(const std::vector<double>& sorted, double q) {
+		double pos = q*(sorted.size() - 1);
+		size_t lower = static_cast<size_t>(std::floor(pos));
+		size_t upper = std::min(lower + 1, sorted.size() - 1);
+		double frac = pos - lower;
+		return sorted[lower] + frac*(sorted[upper] - sorted[lower]);
+	}
+
+	void meanAndStddev(const std::vector<double>& values, double& mean, double& stddev) {
+		double sum = 0.0;
+		for(auto v: values) sum += v;
+		mean = sum/values.size();
+
+		double sqSum = 0.0;
+		for(auto v: values) sqSum += (v - mean)*(v - mean);
+		stddev = (values.size() > 1) ? std::sqrt(sqSum/(values.size() - 1)) : 0.0;
+	}
+}
+
+namespace Statistics {
+
+SummaryStatistics summarize(std::vector<double> values) {
+	SummaryStatistics s;
+	if (values.empty()) return s;
+
+	std::sort(values.begin(), values.end());
+	s.min = values.front();
+	s.firstQuartile = quantile(values, 0.25);
+	s.median = quantile(values, 0.5);
+	s.thirdQuartile = quantile(values, 0.75);
+	s.max = values.back();
+	meanAndStddev(values, s.mean, s.stddev);
+
+	return s;
+}
+
+SummaryStatistics summarizeHarmonic(std::vector<double> values) {
+	SummaryStatistics s = summarize(values);
+	if (values.empty()) return s;
+
+	/* statistics of reciprocals, converted back (see Graph500 reference implementation) */
+	std::vector<double> reciprocals;
+	for(auto v: values) reciprocals.push_back(1.0/v);
+	double rMean, rStddev;
+	meanAndStddev(reciprocals, rMean, rStddev);
+
+	s.mean = 1.0/rMean;
+	s.stddev = (values.size() > 1) ? rStddev/(rMean*rMean*std::sqrt(values.size() - 1)) : 0.0;
+
+	return s;
+}
+
+}
@@ -0,0 +1,31 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#ifndef FRAMEWORK_STATISTICS_H
+#define FRAMEWORK_STATISTICS_H
+
+#include <vector>
+#include <string>
+
+/**
+ * Summary of a series of measurements, in the form used by Graph500 reports
+ */
+struct SummaryStatistics {
+	double min = 0.0;
+	double firstQuartile = 0.0;
+	double median = 0.0;
+	double thirdQuartile = 0.0;
+	double max = 0.0;
+	double mean = 0.0;
+	double stddev = 0.0;
+};
+
+namespace Statistics {
+	/* arithmetic mean & sample standard deviation; quartiles are linearly interpolated */
+	SummaryStatistics summarize(std::vector<double> values);
+	/* for rates (e.g. TEPS) - mean & stddev are harmonic ones, as required by Graph500 */
+	SummaryStatistics summarizeHarmonic(std::vector<double> values);
+}
+
+#endif //FRAMEWORK_STATISTICS_H
@@ -11,11 +11,16 @@
 #include <algorithm>
 #include <glog/logging.h>
 #include <boost/numeric/conversion/cast.hpp>
+#include <mpi.h>
 #include <Prerequisites.h>
 #include <GraphPartition.h>
+#include <Executor.h>
+#include <utils/Config.h>
 #include <utils/CsvReader.h>
+#include <utils/GraphGenerators.h>
 #include <utils/IndexPartitioner.h>
 #include <representations/ArrayBackedChunkedPartition.h>
+#include <representations/GeneratedGraphHandle.h>
 
 namespace details {
 	using namespace IndexPartitioner;
@@ -114,6 +119,42 @@ void bfsSolutionAsGidsDestroy(std::pair<TGlobalId*, GraphDist*> valueReturned) {
 	delete[] valueReturned.second;
 }
 
+/* handle of Kronecker graph partitioned across MPI_COMM_WORLD (see ABCGeneratedGraphHandle), must be deleted */
+template <typename TGHandle = ABCGeneratedGraphHandle<int, int>>
+TGHandle* generatedGraphHandle(unsigned int scale,
+                               unsigned int edgeFactor,
+                               std::vector<OriginalVertexId> verticesToConvert = {}) {
+	int rank, size;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+	GraphGenerators::Params params;
+	params.scale = scale;
+	params.edgeFactor = edgeFactor;
+	return new TGHandle(params, size, rank, verticesToConvert);
+}
+
+/**
+ * Runs TAssembly (constructed from graph handle) on generated graph with given configuration and passes it to check
+ * before executor & graph are destroyed. Collective.
+ */
+template <typename TAssembly, typename TGHandle = ABCGeneratedGraphHandle<int, int>, typename TCheck>
+void runOnGeneratedGraph(unsigned int scale,
+                         unsigned int edgeFactor,
+                         ConfigMap cm,
+                         std::vector<OriginalVertexId> verticesToConvert,
+                         TCheck check) {
+	auto *graphHandle = generatedGraphHandle<TGHandle>(scale, edgeFactor, verticesToConvert);
+	{
+		Executor executor(cm, false);
+		auto* assembly = new TAssembly(*graphHandle);
+		executor.registerAssembly("t", assembly);
+		executor.executeAssembly("t");
+		check(*assembly);
+	}
+	delete graphHandle;
+}
+
 #define CAP_PRINT(EXPR) #EXPR ": " << EXPR << " "
 
 #endif //FRAMEWORK_TESTUTILS_H
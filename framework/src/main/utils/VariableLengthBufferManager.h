@@ -6,34 +6,90 @@
 #define FRAMEWORK_VARIABLELENGTHBUFFERMANAGER_H
 
 
+#include <algorithm>
 #include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <mpi.h>
 
+/**
+ * Receive buffers of variable length, one per slot (so that several receives can be in flight at once). Capacity of
+ * a slot is kept between calls and grows geometrically, so reallocation happens only when a message larger than any
+ * previous one arrives.
+ *
+ * Memory can be allocated with MPI_Alloc_mem (which may return memory registered with the network) - in that case
+ * MPI must be initialized for the whole lifetime of the manager.
+ */
 template <class T> class VariableLengthBufferManager {
+	static_assert(std::is_trivially_copyable<T>::value, "buffers are filled by MPI, so T must be trivially copyable");
+
 public:
-	VariableLengthBufferManager() : buffer(nullptr), size(0) {}
+	VariableLengthBufferManager(size_t slotCount = 1, bool useMpiMemory = false)
+			: slots(slotCount), useMpiMemory(useMpiMemory) {}
 
 	~VariableLengthBufferManager() {
-		if(buffer != nullptr) delete[] buffer;
+		for(auto& s: slots) release(s);
 	}
 
 	/**
+	 * Contents are not preserved when buffer grows
 	 *
 	 * @param expectedCapacity
-	 * @return pointer remains valid until next call to getBuffer
+	 * @return pointer remains valid until next call to getBuffer for the same slot
 	 */
-	T* getBuffer(size_t expectedCapacity) {
-		if(buffer != nullptr) delete[] buffer;
-		size = expectedCapacity;
-		buffer = new T[expectedCapacity];
-		return buffer;
+	T* getBuffer(size_t expectedCapacity, size_t slot = 0) {
+		auto& s = slots.at(slot);
+		if (expectedCapacity > s.capacity || s.buffer == nullptr) {
+			size_t newCapacity = std::max(std::max(expectedCapacity, 2*s.capacity), static_cast<size_t>(1));
+			release(s);
+			s.buffer = allocate(newCapacity);
+			s.capacity = newCapacity;
+		}
+		return s.buffer;
+	}
+
+	/* buffer returned by the last call to getBuffer for that slot */
+	T* getCurrentBuffer(size_t slot = 0) {
+		return slots.at(slot).buffer;
+	}
+
+	size_t getCapacity(size_t slot = 0) const {
+		return slots.at(slot).capacity;
+	}
+
+	size_t getSlotCount() const {
+		return slots.size();
 	}
 
 	VariableLengthBufferManager(const VariableLengthBufferManager&) = delete;
 	VariableLengthBufferManager& operator=(const VariableLengthBufferManager&) = delete;
 
 private:
-	T* buffer;
-	size_t size;
+	struct Slot {
+		T* buffer = nullptr;
+		size_t capacity = 0;
+	};
+
+	std::vector<Slot> slots;
+	bool useMpiMemory;
+
+	T* allocate(size_t count) {
+		if (!useMpiMemory) return new T[count];
+
+		T* memory = nullptr;
+		if (MPI_Alloc_mem(static_cast<MPI_Aint>(count*sizeof(T)), MPI_INFO_NULL, &memory) != MPI_SUCCESS)
+			throw std::runtime_error("MPI_Alloc_mem failed");
+		return memory;
+	}
+
+	void release(Slot& s) {
+		if (s.buffer == nullptr) return;
+		if (useMpiMemory) MPI_Free_mem(s.buffer);
+		else delete[] s.buffer;
+		s.buffer = nullptr;
+		s.capacity = 0;
+	}
 };
 
 
@@ -8,7 +8,9 @@
 #include <utility>
 #include <climits>
 #include <unordered_map>
+#include <vector>
 #include <functional> /* for std::function */
+#include <memory>
 #include <utility> /* for std::pair */
 #include <glog/logging.h>
 #include <mpi.h>
@@ -16,20 +18,45 @@
 #include <utils/MPIAsync.h>
 #include <utils/GrouppingMpiAsync.h>
 #include <utils/MpiTypemap.h>
+#include <utils/SharedArray.h>
 
 namespace details {
+	/* distance exposed by BfsValidator for vertices which BFS has not reached */
+	const GraphDist UNREACHED_DISTANCE = -1;
+
 	/**
 	 * Assumes that MPI has already been initialized (and shutdown is handled by caller)
 	 */
 	template <typename TGraphPartition, typename TGlobalId>
 	class Comms {
 	public:
-		Comms(TGraphPartition *_g, std::pair<TGlobalId*, GraphDist*> partialSolution) : g(_g) {
-			MPI_Win_create(partialSolution.second, g->masterVerticesMaxCount()*sizeof(GraphDist), sizeof(GraphDist),
+		/**
+		 * @param sharedMemory - distances are copied to memory shared by ranks of the same host, so that they don't
+		 *  need MPI_Rget to read each other's distances
+		 */
+		Comms(TGraphPartition *_g, std::pair<TGlobalId*, GraphDist*> partialSolution, bool sharedMemory = false) : g(_g) {
+			GraphDist* exposed = partialSolution.second;
+			if (sharedMemory) {
+				shared.reset(new SharedArray<GraphDist>(g->masterVerticesMaxCount()));
+				std::copy(exposed, exposed + g->masterVerticesMaxCount(), shared->data());
+				shared->publish();
+				exposed = shared->data();
+			}
+
+			MPI_Win_create(exposed, g->masterVerticesMaxCount()*sizeof(GraphDist), sizeof(GraphDist),
 			               MPI_INFO_NULL, MPI_COMM_WORLD, &solutionWin);
 			MPI_Win_lock_all(0, solutionWin);
 		}
 
+		/* true (and distance set) if owner of id runs on this host and distance can be read directly */
+		bool getLocalDistance(const TGlobalId id, GraphDist& distance) const {
+			if (!shared) return false;
+			auto owner = g->toMasterNodeId(id);
+			if (!shared->onThisHost(owner)) return false;
+			distance = shared->segmentOf(owner)[g->toLocalId(id)];
+			return true;
+		}
+
 		/**
 		 *
 		 * @param id
@@ -61,6 +88,8 @@ namespace details {
 	private:
 		TGraphPartition * const g;
 		MPI_Win solutionWin;
+		/* window is created over shared memory, so it must be freed first */
+		std::unique_ptr<SharedArray<GraphDist>> shared;
 	};
 
 	template <typename TGraphPartition, typename TGlobalId>
@@ -74,6 +103,12 @@ namespace details {
 				: mpiAsync(_asyncExecutor), comms(_comms), g(g) {}
 
 		void scheduleGetDistance(const TGlobalId id, std::function<void(GraphDist)> cb) {
+			GraphDist localDistance;
+			if (comms.getLocalDistance(id, localDistance)) {
+				cb(localDistance);
+				return;
+			}
+
 			ull numId = g.toNumeric(id);
 			auto it = distanceMap.find(numId);
 			if (it != distanceMap.end()) {
@@ -123,21 +158,43 @@ private:
 	IMPORT_ALIASES(TGraphPartition)
 
 public:
-	BfsValidator(const GlobalId _root) : root(_root) {};
+	BfsValidator(const GlobalId _root, bool sharedMemory = false) : root(_root), sharedMemory(sharedMemory) {};
 
 	// @ToDo - (types) path length should be parametrizable + registering type with MPI
 	bool validate(TGraphPartition *g, std::pair<GlobalId*, GraphDist*> *partialSolution) {
+		/* distances as seen by other nodes - unreached vertices are marked, so that edges leaving the BFS tree can be
+		 * detected */
+		std::vector<GraphDist> exposedDistances(g->masterVerticesMaxCount(), details::UNREACHED_DISTANCE);
+		g->foreachMasterVertex([&exposedDistances, partialSolution, g](const LocalId id) {
+			if(g->isValid(partialSolution->first[id])) exposedDistances[id] = partialSolution->second[id];
+			return ITER_PROGRESS::CONTINUE;
+		});
+
 		GrouppingMpiAsync executor;
-		details::Comms<TGraphPartition, GlobalId> comms(g, *partialSolution);
+		details::Comms<TGraphPartition, GlobalId> comms(g, std::make_pair(partialSolution->first, exposedDistances.data()),
+		                                                sharedMemory);
 		details::DistanceChecker<TGraphPartition, GlobalId> dc(executor, comms, *g);
 
-		int checkedCount = 0;
+		size_t checkedCount = 0;
+		size_t expectedCount = g->masterVerticesCount();
 		bool valid = true;
-		g->foreachMasterVertex([&dc, &valid, &checkedCount, partialSolution, g, this](const LocalId id) {
+		g->foreachMasterVertex([&dc, &valid, &checkedCount, &expectedCount, partialSolution, g, this](const LocalId id) {
 			const GlobalId currGID = g->toGlobalId(id);
 			const GlobalId predecessor = partialSolution->first[id];
 			GraphDist actualDistance = partialSolution->second[id];
 
+			/* vertex has not been reached (graph is not connected), so its distance is meaningless - only root must
+			 * always be reached */
+			if(!g->isValid(predecessor)) {
+				if(g->isSame(currGID, root)) {
+					LOG(INFO) << "Root " << g->idToString(root) << " has not been reached";
+					valid = false;
+				}
+
+				checkedCount += 1;
+				return ITER_PROGRESS::CONTINUE;
+			}
+
 			/* check if distance positive */
 			if(actualDistance < 0) {
 				LOG(INFO) << "Failure for " << g->idToString(currGID) << "(precedessor: " << g->idToString(predecessor)
@@ -177,11 +234,32 @@ public:
 				checkedCount += 1;
 			}
 
+			/* every edge of a reached vertex must lead to reached vertex, at most one level further or closer */
+			g->foreachNeighbouringVertex(id, [&dc, &valid, &checkedCount, &expectedCount, g, currGID, actualDistance]
+					(const GlobalId nid) {
+				auto checkEdgeCb = [&valid, &checkedCount, g, currGID, nid, actualDistance](GraphDist neighbourDistance) {
+					bool thisValid = neighbourDistance != details::UNREACHED_DISTANCE &&
+					                 neighbourDistance >= actualDistance - 1 && neighbourDistance <= actualDistance + 1;
+
+					if(!thisValid) {
+						LOG(INFO) << "Failure for edge " << g->idToString(currGID) << " - " << g->idToString(nid)
+						          << ": distances " << actualDistance << " and " << neighbourDistance;
+					}
+
+					valid = valid && thisValid;
+					checkedCount += 1;
+				};
+
+				expectedCount += 1;
+				dc.scheduleGetDistance(nid, checkEdgeCb);
+				return ITER_PROGRESS::CONTINUE;
+			});
+
 			return ITER_PROGRESS::CONTINUE;
 		});
 
 		comms.flushAll();
-		while(checkedCount < g->masterVerticesCount()) {
+		while(checkedCount < expectedCount) {
 			executor.poll();
 		}
 
@@ -190,6 +268,7 @@ public:
 
 private:
 	const GlobalId root;
+	const bool sharedMemory;
 };
 
 
@@ -5,25 +5,82 @@
 #ifndef FRAMEWORK_COLOURINGVALIDATOR_H
 #define FRAMEWORK_COLOURINGVALIDATOR_H
 
+#include <vector>
+#include <algorithm>
+#include <memory>
 #include <mpi.h>
 #include <glog/logging.h>
 #include <utils/MPIAsync.h>
+#include <utils/Config.h>
+#include <utils/MpiTypemap.h>
+#include <utils/SharedArray.h>
 #include <Validator.h>
+#include <representations/GhostLayer.h>
 #include <algorithms/Colouring.h>
 
+enum class ColouringValidatorMode {
+	/* one MPI_Rget per cross-node edge (or direct read, if shared memory is enabled and nodes are on the same host) */
+	RMA,
+	/* colours of all remote neighbours gathered at once as ghosts (see GhostLayer), then edges are checked locally */
+	BULK,
+};
+
+namespace details { namespace ColouringValidator {
+	const std::string MODE_OPT = "cv-mode";
+
+	inline ColouringValidatorMode modeFromConfig(ConfigMap cm) {
+		auto it = cm.find(MODE_OPT);
+		if (it == cm.end() || it->second == "rma") {
+			return ColouringValidatorMode::RMA;
+		} else if (it->second == "bulk") {
+			return ColouringValidatorMode::BULK;
+		} else {
+			throw std::runtime_error("Unknown value of " + MODE_OPT + ": " + it->second + " (expected rma|bulk)");
+		}
+	}
+}}
+
 template <typename TGraphPartition>
 class ColouringValidator : public Validator<TGraphPartition, VertexColour *> {
 private:
 	IMPORT_ALIASES(TGraphPartition)
 
-public: /* @todo: finish rewriting validator */
+public:
+	ColouringValidator(ColouringValidatorMode mode = ColouringValidatorMode::RMA, bool sharedMemory = false)
+			: mode(mode), sharedMemory(sharedMemory) {}
+
 	bool validate(TGraphPartition *g, VertexColour *partialSolution) {
+		switch(mode) {
+			case ColouringValidatorMode::BULK:
+				return validateBulk(g, partialSolution);
+			case ColouringValidatorMode::RMA:
+			default:
+				return validateRma(g, partialSolution);
+		}
+	}
+
+private:
+	const ColouringValidatorMode mode;
+	const bool sharedMemory;
+
+	/* @todo: finish rewriting validator */
+	bool validateRma(TGraphPartition *g, VertexColour *partialSolution) {
 		int nodeId;
 		MPI_Comm_rank(MPI_COMM_WORLD, &nodeId);
 		LOG(INFO) << "Entering validator";
 
+		/* colours of other nodes on this host are read directly */
+		std::unique_ptr<SharedArray<VertexColour>> shared;
+		VertexColour* exposed = partialSolution;
+		if (sharedMemory) {
+			shared.reset(new SharedArray<VertexColour>(g->masterVerticesMaxCount()));
+			std::copy(partialSolution, partialSolution + g->masterVerticesMaxCount(), shared->data());
+			shared->publish();
+			exposed = shared->data();
+		}
+
 		MPI_Win partialSolutionWin;
-		MPI_Win_create(partialSolution, g->masterVerticesMaxCount()*sizeof(VertexColour), sizeof(VertexColour),
+		MPI_Win_create(exposed, g->masterVerticesMaxCount()*sizeof(VertexColour), sizeof(VertexColour),
 		               MPI_INFO_NULL, MPI_COMM_WORLD, &partialSolutionWin);
 		MPI_Win_lock_all(0, partialSolutionWin);
 		LOG(INFO) << "Created and locked window";
@@ -32,7 +89,8 @@ public: /* @todo: finish rewriting validator */
 
 		LOG(INFO) << "Starting local vertex scan";
 		bool solutionCorrect = true;
-		int processed = 0;
+		size_t processed = 0;
+		size_t edgesSeen = 0;
 		size_t requestsMade = 0;
 		/* @todo: correct indentation & wrapping - tweak CLion rules */
 		g->foreachMasterVertex([&, g, partialSolution, nodeId](const LocalId v_id) {
@@ -55,6 +113,14 @@ public: /* @todo: finish rewriting validator */
 					processed += 1;
 				} else {
 				#endif
+				if (shared && shared->onThisHost(g->toMasterNodeId(neigh_id))) {
+					auto neighColour = shared->segmentOf(g->toMasterNodeId(neigh_id))[neighLocalId];
+					if (neighColour == partialSolution[v_id]) {
+						LOG(ERROR) << "Illegal colouring between local and remote node";
+						solutionCorrect = false;
+					}
+					processed += 1;
+				} else {
 					/* need to query other node */
 					int *colour = new int;
 					MPI_Request	*rq = new MPI_Request;
@@ -69,11 +135,13 @@ public: /* @todo: finish rewriting validator */
 						delete colour;
 						processed += 1;
 					});
+				}
 				#ifndef GCM_NO_LOCAL_SHORTCIRCUIT
 				}
 				#endif
 
 				requestsMade += 1;
+				edgesSeen += 1;
 
 				return ITER_PROGRESS::CONTINUE;
 			});
@@ -92,7 +160,8 @@ public: /* @todo: finish rewriting validator */
 		MPI_Win_flush_all(partialSolutionWin);
 
 		LOG(INFO) << "Entering polling loop";
-		while(processed < g->masterVerticesCount()) {
+		/* every edge is counted as processed once its check is done (remote ones asynchronously) */
+		while(processed < edgesSeen) {
 			scheduler.pollAll();
 		}
 		LOG(INFO) << "Polling done, shutting down";
@@ -115,6 +184,47 @@ public: /* @todo: finish rewriting validator */
 
 		return allProcessesHaveCorrect;
 	}
+
+	/* colours of remote neighbours are brought in as ghosts (see GhostLayer), then every edge is checked locally */
+	bool validateBulk(TGraphPartition *g, VertexColour *partialSolution) {
+		int nodeId;
+		MPI_Comm_rank(MPI_COMM_WORLD, &nodeId);
+		LOG(INFO) << "Entering validator (bulk mode)";
+
+		GhostLayer<TGraphPartition> ghosts(*g);
+		std::vector<VertexColour> colours(g->masterVerticesMaxCount() + ghosts.ghostsCount());
+		std::copy(partialSolution, partialSolution + g->masterVerticesMaxCount(), colours.begin());
+		ghosts.refreshGhosts(colours.data(), VERTEX_COLOUR_MPI_TYPE);
+
+		bool solutionCorrect = true;
+		g->foreachMasterVertex([&](const LocalId v_id) {
+			g->foreachNeighbouringVertex(v_id, [&](const GlobalId neigh_id) {
+				auto owner = g->toMasterNodeId(neigh_id);
+				auto neighLocalId = g->toLocalId(neigh_id);
+				if (owner != nodeId) neighLocalId = ghosts.toGhostId(owner, neighLocalId);
+
+				if (colours[neighLocalId] == partialSolution[v_id]) {
+					solutionCorrect = false;
+					LOG(INFO) << "Failure: "
+					          << g->idToString(v_id) << "(" << g->toNumeric(v_id) << ") "
+					          << "colour: " << partialSolution[v_id] << ", "
+					          << g->idToString(neigh_id) << "(" << g->toNumeric(neigh_id) << ") "
+					          << "colour: " << colours[neighLocalId];
+				}
+
+				return ITER_PROGRESS::CONTINUE;
+			});
+
+			return ITER_PROGRESS::CONTINUE;
+		});
+
+		LOG(INFO) << "All edges checked";
+
+		bool allProcessesHaveCorrect = false;
+		MPI_Allreduce(&solutionCorrect, &allProcessesHaveCorrect, 1, MPI_CXX_BOOL, MPI_LAND, MPI_COMM_WORLD);
+
+		return allProcessesHaveCorrect;
+	}
 };
 
 
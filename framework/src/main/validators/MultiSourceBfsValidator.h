@@ -0,0 +1,46 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#ifndef FRAMEWORK_MULTISOURCEBFSVALIDATOR_H
+#define FRAMEWORK_MULTISOURCEBFSVALIDATOR_H
+
+#include <vector>
+#include <utility>
+#include <glog/logging.h>
+#include <Validator.h>
+#include <validators/BfsValidator.h>
+
+/**
+ * Validates result of each root separately, using BfsValidator
+ */
+template <class TGraphPartition>
+class MultiSourceBfsValidator
+		: public Validator<TGraphPartition, std::vector<std::pair<typename TGraphPartition::GidType*, GraphDist*>>*> {
+private:
+	IMPORT_ALIASES(TGraphPartition)
+
+public:
+	MultiSourceBfsValidator(const std::vector<GlobalId> _roots, bool sharedMemory = false)
+			: roots(_roots), sharedMemory(sharedMemory) {};
+
+	bool validate(TGraphPartition *g, std::vector<std::pair<GlobalId*, GraphDist*>> *partialSolution) {
+		bool allValid = true;
+		for(size_t i = 0; i < roots.size(); i++) {
+			BfsValidator<TGraphPartition> validator(roots[i], sharedMemory);
+			bool valid = validator.validate(g, &(partialSolution->at(i)));
+			if (!valid) {
+				LOG(ERROR) << "Validation failed for root " << g->idToString(roots[i]);
+			}
+			allValid = allValid && valid;
+		}
+
+		return allValid;
+	}
+
+private:
+	const std::vector<GlobalId> roots;
+	const bool sharedMemory;
+};
+
+#endif //FRAMEWORK_MULTISOURCEBFSVALIDATOR_H
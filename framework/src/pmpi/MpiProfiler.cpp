@@ -0,0 +1,436 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+/**
+ * Optional PMPI interposition layer (see FRAMEWORK_PMPI in CMakeLists.txt). Wrapped calls are forwarded to their
+ * PMPI_ counterparts, recording per probe phase (outermost ProbeRegistry scope, e.g. "Algorithm" or "Validation"):
+ *  - number of calls and time spent in them
+ *  - rank x rank matrix of bytes & messages: row i, column j - what rank i sent to (send/put) or requested from
+ *    (get) rank j. Collectives other than alltoall(v) contribute to call statistics only.
+ *
+ * Everything is gathered on rank 0 in MPI_Finalize (that is, when Executor shuts down) and logged; if
+ * FRAMEWORK_PMPI_OUT environment variable is set, it's also written there as JSON.
+ *
+ * Single-threaded use of MPI is assumed.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <mpi.h>
+#include <glog/logging.h>
+#include <utils/ProbeRegistry.h>
+
+namespace {
+	enum Call {
+		SEND, ISEND, RECV, IRECV, PROBE, IPROBE,
+		SEND_INIT, RECV_INIT, START, STARTALL,
+		TEST, TESTANY, TESTSOME, TESTALL,
+		WAIT, WAITANY, WAITSOME, WAITALL,
+		BARRIER, BCAST, ALLREDUCE, ALLGATHER, ALLGATHERV, ALLTOALL, ALLTOALLV,
+		GET, RGET, PUT, WIN_FLUSH_ALL,
+		CALL_COUNT
+	};
+
+	const char* CALL_NAMES[CALL_COUNT] = {
+		"MPI_Send", "MPI_Isend", "MPI_Recv", "MPI_Irecv", "MPI_Probe", "MPI_Iprobe",
+		"MPI_Send_init", "MPI_Recv_init", "MPI_Start", "MPI_Startall",
+		"MPI_Test", "MPI_Testany", "MPI_Testsome", "MPI_Testall",
+		"MPI_Wait", "MPI_Waitany", "MPI_Waitsome", "MPI_Waitall",
+		"MPI_Barrier", "MPI_Bcast", "MPI_Allreduce", "MPI_Allgather", "MPI_Allgatherv", "MPI_Alltoall", "MPI_Alltoallv",
+		"MPI_Get", "MPI_Rget", "MPI_Put", "MPI_Win_flush_all"
+	};
+
+	const char* OUTPUT_ENV = "FRAMEWORK_PMPI_OUT";
+	const std::string UNSCOPED_PHASE = "(unscoped)";
+
+	struct PhaseStats {
+		unsigned long long calls[CALL_COUNT] = {};
+		unsigned long long nanos[CALL_COUNT] = {};
+		/* indexed by world rank of the peer */
+		std::vector<unsigned long long> bytesTo;
+		std::vector<unsigned long long> messagesTo;
+	};
+
+	/* message sent each time persistent send request is started */
+	struct PersistentSend {
+		int worldPeer;
+		int count;
+		MPI_Datatype datatype;
+	};
+
+	std::map<std::string, PhaseStats> phases;
+	std::map<MPI_Request, PersistentSend> persistentSends;
+	/* disables recording while results are being gathered */
+	bool finalizing = false;
+
+	int worldSize() {
+		static int size = 0;
+		if (size == 0) PMPI_Comm_size(MPI_COMM_WORLD, &size);
+		return size;
+	}
+
+	PhaseStats& statsFor(const std::string& phase) {
+		auto& stats = phases[phase];
+		if (stats.bytesTo.empty()) {
+			stats.bytesTo.resize(worldSize(), 0);
+			stats.messagesTo.resize(worldSize(), 0);
+		}
+		return stats;
+	}
+
+	PhaseStats& currentPhase() {
+		auto& name = ProbeRegistry::instance().currentPhase();
+		return statsFor(name.empty() ? UNSCOPED_PHASE : name);
+	}
+
+	int toWorldRank(int rank, MPI_Group group) {
+		MPI_Group worldGroup;
+		PMPI_Comm_group(MPI_COMM_WORLD, &worldGroup);
+		int worldRank = MPI_UNDEFINED;
+		PMPI_Group_translate_ranks(group, 1, &rank, worldGroup, &worldRank);
+		PMPI_Group_free(&worldGroup);
+		return worldRank;
+	}
+
+	int toWorldRank(int rank, MPI_Comm comm) {
+		if (comm == MPI_COMM_WORLD) return rank;
+
+		MPI_Group group;
+		PMPI_Comm_group(comm, &group);
+		int worldRank = toWorldRank(rank, group);
+		PMPI_Group_free(&group);
+		return worldRank;
+	}
+
+	int toWorldRank(int rank, MPI_Win win) {
+		MPI_Group group;
+		PMPI_Win_get_group(win, &group);
+		int worldRank = toWorldRank(rank, group);
+		PMPI_Group_free(&group);
+		return worldRank;
+	}
+
+	void recordTraffic(int worldPeer, int count, MPI_Datatype dt) {
+		if (finalizing || worldPeer < 0 || worldPeer >= worldSize()) return;
+
+		int typeSize = 0;
+		PMPI_Type_size(dt, &typeSize);
+		auto& stats = currentPhase();
+		stats.bytesTo[worldPeer] += static_cast<unsigned long long>(count)*typeSize;
+		stats.messagesTo[worldPeer] += 1;
+	}
+
+	void startedPersistent(MPI_Request request) {
+		auto it = persistentSends.find(request);
+		if (it != persistentSends.end()) recordTraffic(it->second.worldPeer, it->second.count, it->second.datatype);
+	}
+
+	/* runs pmpiCall (and nothing else, so that bookkeeping above isn't measured) & records it with its duration */
+	template <typename F>
+	int timed(Call call, F pmpiCall) {
+		auto start = std::chrono::steady_clock::now();
+		int result = pmpiCall();
+		auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+		if (!finalizing) {
+			auto& stats = currentPhase();
+			stats.calls[call] += 1;
+			stats.nanos[call] += nanos.count();
+		}
+		return result;
+	}
+
+	std::vector<std::string> gatherPhaseNames() {
+		std::string joined;
+		for(auto& p: phases) {
+			joined += p.first;
+			joined += '\n';
+		}
+
+		int size = worldSize();
+		int localLength = static_cast<int>(joined.size());
+		std::vector<int> lengths(size), displs(size);
+		PMPI_Allgather(&localLength, 1, MPI_INT, lengths.data(), 1, MPI_INT, MPI_COMM_WORLD);
+		int total = 0;
+		for(int i = 0; i < size; i++) {
+			displs[i] = total;
+			total += lengths[i];
+		}
+
+		std::vector<char> all(static_cast<size_t>(total));
+		PMPI_Allgatherv(joined.data(), localLength, MPI_CHAR, all.data(), lengths.data(), displs.data(), MPI_CHAR,
+		                MPI_COMM_WORLD);
+
+		std::set<std::string> names;
+		std::stringstream ss(std::string(all.begin(), all.end()));
+		std::string name;
+		while(std::getline(ss, name)) names.insert(name);
+		return std::vector<std::string>(names.begin(), names.end());
+	}
+
+	void writeMatrix(std::ostream& os, const std::vector<unsigned long long>& flat, int size) {
+		os << "[";
+		for(int i = 0; i < size; i++) {
+			os << (i == 0 ? "[" : ", [");
+			for(int j = 0; j < size; j++) os << (j == 0 ? "" : ", ") << flat[i*size + j];
+			os << "]";
+		}
+		os << "]";
+	}
+
+	/* collective */
+	void dump() {
+		int rank;
+		PMPI_Comm_rank(MPI_COMM_WORLD, &rank);
+		int size = worldSize();
+		auto names = gatherPhaseNames();
+
+		std::stringstream json;
+		json << "{\n  \"ranks\": " << size << ",\n  \"phases\": {";
+
+		for(size_t p = 0; p < names.size(); p++) {
+			auto& stats = statsFor(names[p]);
+
+			std::vector<unsigned long long> callsSum(CALL_COUNT), nanosSum(CALL_COUNT), nanosMax(CALL_COUNT);
+			PMPI_Reduce(stats.calls, callsSum.data(), CALL_COUNT, MPI_UNSIGNED_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+			PMPI_Reduce(stats.nanos, nanosSum.data(), CALL_COUNT, MPI_UNSIGNED_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+			PMPI_Reduce(stats.nanos, nanosMax.data(), CALL_COUNT, MPI_UNSIGNED_LONG_LONG, MPI_MAX, 0, MPI_COMM_WORLD);
+
+			std::vector<unsigned long long> bytes(rank == 0 ? size*size : 0), messages(rank == 0 ? size*size : 0);
+			PMPI_Gather(stats.bytesTo.data(), size, MPI_UNSIGNED_LONG_LONG, bytes.data(), size, MPI_UNSIGNED_LONG_LONG,
+			            0, MPI_COMM_WORLD);
+			PMPI_Gather(stats.messagesTo.data(), size, MPI_UNSIGNED_LONG_LONG, messages.data(), size,
+			            MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD);
+
+			if (rank != 0) continue;
+
+			json << (p == 0 ? "\n" : ",\n") << "    \"" << names[p] << "\": {\n      \"calls\": {";
+			bool first = true;
+			for(int c = 0; c < CALL_COUNT; c++) {
+				if (callsSum[c] == 0) continue;
+
+				json << (first ? "\n" : ",\n") << "        \"" << CALL_NAMES[c] << "\": {\"count\": " << callsSum[c]
+				     << ", \"seconds_sum\": " << nanosSum[c]/1e9 << ", \"seconds_max_rank\": " << nanosMax[c]/1e9 << "}";
+				first = false;
+
+				LOG(INFO) << "PMPI " << names[p] << " " << CALL_NAMES[c] << ": " << callsSum[c] << " calls, "
+				          << nanosSum[c]/1e9 << "s total, " << nanosMax[c]/1e9 << "s on slowest rank";
+			}
+			json << (first ? "}" : "\n      }") << ",\n      \"bytes\": ";
+			writeMatrix(json, bytes, size);
+			json << ",\n      \"messages\": ";
+			writeMatrix(json, messages, size);
+			json << "\n    }";
+
+			for(int i = 0; i < size; i++) {
+				unsigned long long rowBytes = 0, rowMessages = 0;
+				for(int j = 0; j < size; j++) {
+					rowBytes += bytes[i*size + j];
+					rowMessages += messages[i*size + j];
+				}
+				LOG(INFO) << "PMPI " << names[p] << " rank " << i << " sent " << rowBytes << " bytes in "
+				          << rowMessages << " messages";
+			}
+		}
+		json << "\n  }\n}\n";
+
+		const char* outPath = std::getenv(OUTPUT_ENV);
+		if (rank == 0 && outPath != nullptr) {
+			std::ofstream out(outPath);
+			if (out) {
+				out << json.str();
+				LOG(INFO) << "PMPI profile written to " << outPath;
+			} else {
+				LOG(ERROR) << "Cannot write PMPI profile to " << outPath;
+			}
+		}
+	}
+}
+
+extern "C" {
+
+int MPI_Send(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm) {
+	recordTraffic(toWorldRank(dest, comm), count, datatype);
+	return timed(SEND, [&] { return PMPI_Send(buf, count, datatype, dest, tag, comm); });
+}
+
+int MPI_Isend(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+              MPI_Request *request) {
+	recordTraffic(toWorldRank(dest, comm), count, datatype);
+	return timed(ISEND, [&] { return PMPI_Isend(buf, count, datatype, dest, tag, comm, request); });
+}
+
+int MPI_Recv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm, MPI_Status *status) {
+	return timed(RECV, [&] { return PMPI_Recv(buf, count, datatype, source, tag, comm, status); });
+}
+
+int MPI_Irecv(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm,
+              MPI_Request *request) {
+	return timed(IRECV, [&] { return PMPI_Irecv(buf, count, datatype, source, tag, comm, request); });
+}
+
+int MPI_Send_init(const void *buf, int count, MPI_Datatype datatype, int dest, int tag, MPI_Comm comm,
+                  MPI_Request *request) {
+	int worldPeer = toWorldRank(dest, comm);
+	int result = timed(SEND_INIT, [&] { return PMPI_Send_init(buf, count, datatype, dest, tag, comm, request); });
+	if (result == MPI_SUCCESS) persistentSends[*request] = PersistentSend{worldPeer, count, datatype};
+	return result;
+}
+
+int MPI_Recv_init(void *buf, int count, MPI_Datatype datatype, int source, int tag, MPI_Comm comm,
+                  MPI_Request *request) {
+	int result = timed(RECV_INIT, [&] { return PMPI_Recv_init(buf, count, datatype, source, tag, comm, request); });
+	if (result == MPI_SUCCESS) persistentSends.erase(*request);
+	return result;
+}
+
+/* traffic of persistent sends is recorded when they are started */
+int MPI_Start(MPI_Request *request) {
+	startedPersistent(*request);
+	return timed(START, [&] { return PMPI_Start(request); });
+}
+
+int MPI_Startall(int count, MPI_Request requests[]) {
+	for(int i = 0; i < count; i++) startedPersistent(requests[i]);
+	return timed(STARTALL, [&] { return PMPI_Startall(count, requests); });
+}
+
+/* not measured, only forgets freed persistent sends */
+int MPI_Request_free(MPI_Request *request) {
+	persistentSends.erase(*request);
+	return PMPI_Request_free(request);
+}
+
+int MPI_Probe(int source, int tag, MPI_Comm comm, MPI_Status *status) {
+	return timed(PROBE, [&] { return PMPI_Probe(source, tag, comm, status); });
+}
+
+int MPI_Iprobe(int source, int tag, MPI_Comm comm, int *flag, MPI_Status *status) {
+	return timed(IPROBE, [&] { return PMPI_Iprobe(source, tag, comm, flag, status); });
+}
+
+int MPI_Test(MPI_Request *request, int *flag, MPI_Status *status) {
+	return timed(TEST, [&] { return PMPI_Test(request, flag, status); });
+}
+
+int MPI_Testany(int count, MPI_Request requests[], int *index, int *flag, MPI_Status *status) {
+	return timed(TESTANY, [&] { return PMPI_Testany(count, requests, index, flag, status); });
+}
+
+int MPI_Testsome(int incount, MPI_Request requests[], int *outcount, int indices[], MPI_Status statuses[]) {
+	return timed(TESTSOME, [&] { return PMPI_Testsome(incount, requests, outcount, indices, statuses); });
+}
+
+int MPI_Testall(int count, MPI_Request requests[], int *flag, MPI_Status statuses[]) {
+	return timed(TESTALL, [&] { return PMPI_Testall(count, requests, flag, statuses); });
+}
+
+int MPI_Wait(MPI_Request *request, MPI_Status *status) {
+	return timed(WAIT, [&] { return PMPI_Wait(request, status); });
+}
+
+int MPI_Waitany(int count, MPI_Request requests[], int *index, MPI_Status *status) {
+	return timed(WAITANY, [&] { return PMPI_Waitany(count, requests, index, status); });
+}
+
+int MPI_Waitsome(int incount, MPI_Request requests[], int *outcount, int indices[], MPI_Status statuses[]) {
+	return timed(WAITSOME, [&] { return PMPI_Waitsome(incount, requests, outcount, indices, statuses); });
+}
+
+int MPI_Waitall(int count, MPI_Request requests[], MPI_Status statuses[]) {
+	return timed(WAITALL, [&] { return PMPI_Waitall(count, requests, statuses); });
+}
+
+int MPI_Barrier(MPI_Comm comm) {
+	return timed(BARRIER, [&] { return PMPI_Barrier(comm); });
+}
+
+int MPI_Bcast(void *buffer, int count, MPI_Datatype datatype, int root, MPI_Comm comm) {
+	return timed(BCAST, [&] { return PMPI_Bcast(buffer, count, datatype, root, comm); });
+}
+
+int MPI_Allreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+	return timed(ALLREDUCE, [&] { return PMPI_Allreduce(sendbuf, recvbuf, count, datatype, op, comm); });
+}
+
+int MPI_Allgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                  MPI_Datatype recvtype, MPI_Comm comm) {
+	return timed(ALLGATHER, [&] {
+		return PMPI_Allgather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+	});
+}
+
+int MPI_Allgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                   const int displs[], MPI_Datatype recvtype, MPI_Comm comm) {
+	return timed(ALLGATHERV, [&] {
+		return PMPI_Allgatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, comm);
+	});
+}
+
+int MPI_Alltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                 MPI_Datatype recvtype, MPI_Comm comm) {
+	int size;
+	PMPI_Comm_size(comm, &size);
+	for(int i = 0; i < size; i++) recordTraffic(toWorldRank(i, comm), sendcount, sendtype);
+	return timed(ALLTOALL, [&] {
+		return PMPI_Alltoall(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+	});
+}
+
+int MPI_Alltoallv(const void *sendbuf, const int sendcounts[], const int sdispls[], MPI_Datatype sendtype,
+                  void *recvbuf, const int recvcounts[], const int rdispls[], MPI_Datatype recvtype, MPI_Comm comm) {
+	int size;
+	PMPI_Comm_size(comm, &size);
+	for(int i = 0; i < size; i++) {
+		if (sendcounts[i] > 0) recordTraffic(toWorldRank(i, comm), sendcounts[i], sendtype);
+	}
+	return timed(ALLTOALLV, [&] {
+		return PMPI_Alltoallv(sendbuf, sendcounts, sdispls, sendtype, recvbuf, recvcounts, rdispls, recvtype, comm);
+	});
+}
+
+int MPI_Get(void *origin_addr, int origin_count, MPI_Datatype origin_datatype, int target_rank, MPI_Aint target_disp,
+            int target_count, MPI_Datatype target_datatype, MPI_Win win) {
+	recordTraffic(toWorldRank(target_rank, win), origin_count, origin_datatype);
+	return timed(GET, [&] {
+		return PMPI_Get(origin_addr, origin_count, origin_datatype, target_rank, target_disp, target_count,
+		                target_datatype, win);
+	});
+}
+
+int MPI_Rget(void *origin_addr, int origin_count, MPI_Datatype origin_datatype, int target_rank, MPI_Aint target_disp,
+             int target_count, MPI_Datatype target_datatype, MPI_Win win, MPI_Request *request) {
+	recordTraffic(toWorldRank(target_rank, win), origin_count, origin_datatype);
+	return timed(RGET, [&] {
+		return PMPI_Rget(origin_addr, origin_count, origin_datatype, target_rank, target_disp, target_count,
+		                 target_datatype, win, request);
+	});
+}
+
+int MPI_Put(const void *origin_addr, int origin_count, MPI_Datatype origin_datatype, int target_rank,
+            MPI_Aint target_disp, int target_count, MPI_Datatype target_datatype, MPI_Win win) {
+	recordTraffic(toWorldRank(target_rank, win), origin_count, origin_datatype);
+	return timed(PUT, [&] {
+		return PMPI_Put(origin_addr, origin_count, origin_datatype, target_rank, target_disp, target_count,
+		                target_datatype, win);
+	});
+}
+
+int MPI_Win_flush_all(MPI_Win win) {
+	return timed(WIN_FLUSH_ALL, [&] { return PMPI_Win_flush_all(win); });
+}
+
+int MPI_Finalize() {
+	finalizing = true;
+	dump();
+	return PMPI_Finalize();
+}
+
+}
@@ -19,23 +19,21 @@ T* uglyInstantiation() {
  * Builders and representations
  */
 #include <representations/ArrayBackedChunkedPartition.h>
-using ABCP_GB = ABCGraphHandle<int,int>;
 using ABCP_GP = ArrayBackedChunkedPartition<int,int>;
-using ABCP_GB_U = ABCGraphHandle<size_t,size_t>;
 using ABCP_GP_U = ArrayBackedChunkedPartition<size_t,size_t>;
+using ABCP_GP_P = ArrayBackedChunkedPartition<size_t,size_t,ABCPPackedGlobalVertexId<>>;
 
 #include <representations/AdjacencyListHashPartition.h>
-using ALHP_GB = ALHGraphHandle<int,int>;
 using ALHP_GP = ALHPGraphPartition<int,int>;
-using ALHP_GB_U = ALHGraphHandle<size_t,size_t>;
 using ALHP_GP_U = ALHPGraphPartition<size_t,size_t>;
 
 #include <representations/RoundRobin2DPartition.h>
-using RR2D_GB = RR2DHandle<int,int>;
 using RR2D_GP = RoundRobin2DPartition<int,int>;
-using RR2D_GB_U = RR2DHandle<size_t,size_t>;
 using RR2D_GP_U = RoundRobin2DPartition<size_t,size_t>;
 
+/* the same list of handles & algorithms as the one available at runtime */
+#include <VariantList.h>
+
 template <typename TGraphBuilder>
 void callEachGhFunction(TGraphBuilder* builder) {
 	builder->getGraph();
@@ -76,41 +74,50 @@ void callEachGpFunction(TGraphPartition* gp) {
 
 void testBuildersAndGraphs() {
 	auto* adjList = new std::vector<TGVID>();
-	callEachGpFunction(new ABCP_GP(new std::vector<ABCP_GP::GidType>(), 0, 0, 0, 0, 0, 0));
-	callEachGpFunction(new ABCP_GP_U(new std::vector<ABCP_GP_U::GidType>(), 0, 0, 0, 0, 0, 0));
+	callEachGpFunction(new ABCP_GP(ABCPAdjacency<ABCP_GP::GidType>(), 0, 0, 0, 0, 0));
+	callEachGpFunction(new ABCP_GP_U(ABCPAdjacency<ABCP_GP_U::GidType>(), 0, 0, 0, 0, 0));
+	callEachGpFunction(new ABCP_GP_P(ABCPAdjacency<ABCP_GP_P::GidType>(), 0, 0, 0, 0, 0));
 	callEachGpFunction(new ALHP_GP(details::GraphData<int, ALHP_GP::GidType>()));
 	callEachGpFunction(new ALHP_GP_U(details::GraphData<size_t, ALHP_GP_U::GidType>()));
 	details::RR2D::MpiTypes mtypes;
 	callEachGpFunction(new RR2D_GP(new details::RR2D::GraphData<int, int>(0, 0, 0, 0, 0, 0, 0, mtypes)));
 	callEachGpFunction(new RR2D_GP_U(new details::RR2D::GraphData<size_t, size_t>(0, 0, 0, 0, 0, 0, 0, mtypes)));
 
-	auto vToConv = std::vector<OriginalVertexId>();
-	callEachGhFunction(new ABCP_GB("", 0, 0, vToConv));
-	callEachGhFunction(new ABCP_GB_U("", 0, 0, vToConv));
-	callEachGhFunction(new ALHP_GB("", vToConv));
-	callEachGhFunction(new ALHP_GB_U("", vToConv));
-	callEachGhFunction(new RR2D_GB("", vToConv));
-	callEachGhFunction(new RR2D_GB_U("", vToConv));
+	#define INSTANTIATE_HANDLE(repr, ids, ...) \
+		callEachGhFunction(createHandle(HandleArgs(), static_cast<__VA_ARGS__*>(nullptr)));
+	FRAMEWORK_LOADED_HANDLES(INSTANTIATE_HANDLE)
+	FRAMEWORK_GENERATED_HANDLES(INSTANTIATE_HANDLE)
+	#undef INSTANTIATE_HANDLE
 }
 
-/*
- * Algorithms
- */
-#include <algorithms/bfs/BfsVarMessage.h>
-using BFS_VM = Bfs_Mp_VarMsgLen_1D_2CommRounds<TestGP>;
-
-#include <algorithms/bfs/BfsFixedMessage.h>
-using BFS_FM = Bfs_Mp_FixedMsgLen_1D_2CommRounds<TestGP>;
+#include <representations/GhostLayer.h>
 
-#include <algorithms/bfs/Bfs1CommsRound.h>
-using BFS_1C = Bfs_Mp_VarMsgLen_1D_1CommsTag<TestGP>;
+template <typename TGraphPartition>
+void callEachGhostLayerFunction(TGraphPartition* gp) {
+	IMPORT_ALIASES(TGraphPartition)
 
-#include <algorithms/colouring/GraphColouringMp.h>
-using COLOUR_MP = GraphColouringMp<TestGP>;
+	GhostLayer<TGraphPartition> gl(*gp);
+	bool isGhost;
+	gl.firstGhostId();
+	gl.ghostsCount();
+	gl.toGhostId(0, 0, &isGhost);
+	gl.foreachGhost([](const LocalId, const NodeId, const LocalId) {return ITER_PROGRESS::STOP;});
+	gl.refreshGhosts(new int[1]);
+}
 
-#include <algorithms/colouring/GraphColouringMpAsync.h>
-using COLOUR_MP_ASYNC = GraphColouringMPAsync<TestGP>;
+void testGhostLayer() {
+	callEachGhostLayerFunction(new ABCP_GP(ABCPAdjacency<ABCP_GP::GidType>(), 0, 0, 0, 0, 0));
+	auto* alhp = new ALHP_GP(details::GraphData<int, ALHP_GP::GidType>());
+	callEachGhostLayerFunction(alhp);
+	alhp->hasGhosts();
+	alhp->ghostVerticesCount();
+	alhp->toGhostId(ALHP_GP::GidType());
+	alhp->refreshGhosts(new int[1]);
+}
 
+/*
+ * Algorithms (see VariantList.h)
+ */
 
 template <typename TAlgo> void callEachAlgoFunctions(TAlgo* algo) {
 	auto G = TestGP();
@@ -120,12 +127,15 @@ template <typename TAlgo> void callEachAlgoFunctions(TAlgo* algo) {
 
 void testAlgorithms() {
 	auto bfsRoot = TGVID();
-	callEachAlgoFunctions(new BFS_VM(bfsRoot));
-	callEachAlgoFunctions(new BFS_FM(bfsRoot));
-	callEachAlgoFunctions(new BFS_1C(bfsRoot));
-
-	callEachAlgoFunctions(new COLOUR_MP());
-	callEachAlgoFunctions(new COLOUR_MP_ASYNC());
+	#define INSTANTIATE_BFS(variant, TAlgo) callEachAlgoFunctions(new TAlgo<TestGP>(bfsRoot));
+	#define INSTANTIATE_MSBFS(variant, TAlgo) callEachAlgoFunctions(new TAlgo<TestGP>({bfsRoot}));
+	#define INSTANTIATE_COLOURING(variant, TAlgo) callEachAlgoFunctions(new TAlgo<TestGP>());
+	FRAMEWORK_BFS_VARIANTS(INSTANTIATE_BFS)
+	FRAMEWORK_MSBFS_VARIANTS(INSTANTIATE_MSBFS)
+	FRAMEWORK_COLOURING_VARIANTS(INSTANTIATE_COLOURING)
+	#undef INSTANTIATE_BFS
+	#undef INSTANTIATE_MSBFS
+	#undef INSTANTIATE_COLOURING
 }
 
 /*
@@ -137,6 +147,9 @@ using V_BFS = BfsValidator<TestGP>;
 #include <validators/ColouringValidator.h>
 using V_COLOUR = ColouringValidator<TestGP>;
 
+#include <validators/MultiSourceBfsValidator.h>
+using V_MSBFS = MultiSourceBfsValidator<TestGP>;
+
 template <typename TValidator>
 void callEachValidatorFunctions(TValidator* algo) {
 	auto G = TestGP();
@@ -149,4 +162,5 @@ void testValidators() {
 	auto bfsRoot = TGVID();
 	callEachValidatorFunctions(new V_BFS(bfsRoot));
 	callEachValidatorFunctions(new V_COLOUR());
+	callEachValidatorFunctions(new V_MSBFS({bfsRoot}));
 }
\ No newline at end of file
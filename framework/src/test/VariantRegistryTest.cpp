@@ -0,0 +1,64 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <VariantRegistry.h>
+
+using namespace details::Variants;
+
+namespace {
+	struct FakeHandle {
+		static int alive;
+		FakeHandle() { alive++; }
+		~FakeHandle() { alive--; }
+	};
+	int FakeHandle::alive = 0;
+
+	class FakeAssembly : public Assembly {
+	protected:
+		void doRun(ConfigMap) override {}
+	};
+
+	VariantRegistry createRegistry() {
+		VariantRegistry registry;
+		auto createHandle = [](const HandleArgs&) { return new FakeHandle(); };
+		auto createAssembly = [](FakeHandle&) { return new FakeAssembly(); };
+		for(auto& ids: {"32", "64"}) {
+			registry.add<FakeHandle>("bfs", "alh", ids, "1tag", createHandle, createAssembly);
+			registry.add<FakeHandle>("bfs", "gen", ids, "fixed", createHandle, createAssembly);
+		}
+		registry.setDefaultIds("alh", "32");
+		registry.setDefaultIds("gen", "64");
+		registry.setAssemblyDefaults("bfs", {{REPRESENTATION_OPT, "alh"}, {VARIANT_OPT, "1tag"}});
+		registry.addAlias("gen-bfs", "bfs", {{REPRESENTATION_OPT, "gen"}, {VARIANT_OPT, "fixed"}});
+		return registry;
+	}
+}
+
+TEST(VariantRegistry, FillsMissingOptionsFromDefaults) {
+	auto registry = createRegistry();
+
+	ASSERT_EQ(registry.resolve("bfs", {}), "bfs:alh:32:1tag");
+	ASSERT_EQ(registry.resolve("bfs", {{IDS_OPT, "64"}}), "bfs:alh:64:1tag");
+	ASSERT_EQ(registry.resolve("gen-bfs", {}), "bfs:gen:64:fixed");
+	ASSERT_EQ(registry.resolve("gen-bfs", {{IDS_OPT, "32"}}), "bfs:gen:32:fixed");
+	ASSERT_EQ(registry.resolve("bfs", {{REPRESENTATION_OPT, "gen"}, {VARIANT_OPT, "fixed"}}), "bfs:gen:64:fixed");
+}
+
+TEST(VariantRegistry, CreatesOnlySelectedCombination) {
+	auto registry = createRegistry();
+
+	ASSERT_TRUE(registry.contains("gen-bfs", {}));
+	ASSERT_FALSE(registry.contains("gen-bfs", {{VARIANT_OPT, "1tag"}}));
+	HandleArgs args;
+	args.config[VARIANT_OPT] = "2rounds";
+	ASSERT_EQ(registry.create("bfs", args), nullptr);
+	ASSERT_EQ(FakeHandle::alive, 0);
+
+	Assembly* assembly = registry.create("bfs", HandleArgs());
+	ASSERT_NE(assembly, nullptr);
+	ASSERT_EQ(FakeHandle::alive, 1);
+	delete assembly;
+	ASSERT_EQ(FakeHandle::alive, 0);
+}
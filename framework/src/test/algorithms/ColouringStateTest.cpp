@@ -0,0 +1,55 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <algorithms/colouring/ColouringState.h>
+
+TEST(ColouringState, FindsFirstFreeColour) {
+	ColouringState state(3);
+
+	ASSERT_EQ(state.firstFree(0), 0);
+
+	state.markUsed(0, 0);
+	state.markUsed(0, 1);
+	state.markUsed(0, 3);
+	state.markUsed(0, 1);
+	ASSERT_EQ(state.firstFree(0), 2);
+	state.markUsed(0, 2);
+	ASSERT_EQ(state.firstFree(0), 4);
+
+	/* other vertices are independent */
+	ASSERT_EQ(state.firstFree(1), 0);
+}
+
+TEST(ColouringState, SpillsColoursAboveInlineMask) {
+	ColouringState state(2);
+
+	for(VertexColour c = 0; c < 64; c++) state.markUsed(1, c);
+	ASSERT_EQ(state.firstFree(1), 64);
+
+	state.markUsed(1, 64);
+	state.markUsed(1, 65);
+	state.markUsed(1, 200);
+	ASSERT_EQ(state.firstFree(1), 66);
+
+	for(VertexColour c = 66; c < 200; c++) state.markUsed(1, c);
+	ASSERT_EQ(state.firstFree(1), 201);
+
+	/* colour above the inline mask doesn't hide free ones below it */
+	state.markUsed(0, 130);
+	ASSERT_EQ(state.firstFree(0), 0);
+}
+
+TEST(ColouringState, CountsNeighboursToWaitFor) {
+	ColouringState state(2);
+
+	state.waitCounter(1)++;
+	state.waitCounter(1)++;
+	state.waitCounter(1) -= 1;
+	ASSERT_EQ(state.waitCounter(0), 0);
+	ASSERT_EQ(state.waitCounter(1), 1);
+
+	state.waitCounter(0) = ColouringState::COLOURED;
+	ASSERT_EQ(state.waitCounter(0), static_cast<long long>(ColouringState::COLOURED));
+}
@@ -111,3 +111,44 @@ TEST(ABCPGraphBuilder, VertexConversion) {
 	ASSERT_EQ(cv[0], GlobalId(0,0));
 	ASSERT_EQ(cv[1], GlobalId(1,1));
 }
+
+TEST(ABCPPackedGlobalVertexId, PacksIntoSingleWord) {
+	using PG = ABCPPackedGlobalVertexId<16>;
+	ASSERT_EQ(sizeof(PG), sizeof(uint64_t));
+
+	PG invalid;
+	ASSERT_LT(invalid.nodeId, 0);
+
+	PG gid(32767, (1ULL << 48) - 1);
+	ASSERT_EQ(gid.nodeId, 32767);
+	ASSERT_EQ(gid.localId, (1ULL << 48) - 1);
+	ASSERT_NE(gid, PG(32767, 0));
+
+	ASSERT_TRUE(PG::canRepresent(1 << 15, 1ULL << 48));
+	ASSERT_FALSE(PG::canRepresent((1 << 15) + 1, 1));
+	ASSERT_FALSE(PG::canRepresent(1, (1ULL << 48) + 1));
+}
+
+TEST(ABCPPackedGlobalVertexId, LoadsSameGraphAsStructIds) {
+	using PackedG = ArrayBackedChunkedPartition<LocalId, NumericId, ABCPPackedGlobalVertexId<>>;
+	ABCGraphHandle<LocalId,NumericId> b(stgPath, 2, 1, {0, 3});
+	ABCGraphHandle<LocalId,NumericId,ABCPPackedGlobalVertexId<>> pb(stgPath, 2, 1, {0, 3});
+
+	auto& gp = b.getGraph();
+	auto& pgp = pb.getGraph();
+
+	std::vector<NumericId> expected, actual;
+	gp.foreachNeighbouringVertex(1, [&expected, &gp](const GlobalId nid) {
+		expected.push_back(gp.toNumeric(nid));
+		return CONTINUE;
+	});
+	pgp.foreachNeighbouringVertex(1, [&actual, &pgp](const PackedG::GidType nid) {
+		actual.push_back(pgp.toNumeric(nid));
+		return CONTINUE;
+	});
+	ASSERT_EQ(expected, actual);
+
+	auto cv = pb.getConvertedVertices();
+	ASSERT_EQ(cv[0], PackedG::GidType(0,0));
+	ASSERT_EQ(cv[1], PackedG::GidType(1,1));
+}
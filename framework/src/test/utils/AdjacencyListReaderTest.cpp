@@ -96,4 +96,28 @@ TEST(AdjacencyListReader, StructureC50) {
 	}
 
 	ASSERT_EQ(actual, expected);
-}
\ No newline at end of file
+}
+
+TEST(AdjacencyListReader, SeeksToVertex) {
+	ALR reader("resources/test/powerlaw_25_2_05_876.adjl");
+	std::vector<VSpec> all;
+	while(boost::optional<VSpec> oVSpec = reader.getNextVertex()) {
+		all.push_back(*oVSpec);
+	}
+
+	/* in any order, including backwards */
+	for(OriginalVertexId vid: {13, 0, 24, 1, 12, 23}) {
+		reader.seekToVertex(vid);
+		ASSERT_EQ(*reader.getNextVertex(), all[vid]);
+	}
+
+	/* reading continues sequentially after seek */
+	reader.seekToVertex(22);
+	ASSERT_EQ(*reader.getNextVertex(), all[22]);
+	ASSERT_EQ(*reader.getNextVertex(), all[23]);
+	ASSERT_EQ(*reader.getNextVertex(), all[24]);
+	ASSERT_FALSE(reader.getNextVertex());
+
+	reader.seekToVertex(25);
+	ASSERT_FALSE(reader.getNextVertex());
+}
@@ -0,0 +1,80 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <utils/GraphGenerators.h>
+
+using namespace GraphGenerators;
+
+namespace {
+	Params paramsFor(Kind kind) {
+		Params p;
+		p.kind = kind;
+		p.scale = 8;
+		p.edgeFactor = 8;
+		p.seed = 7;
+		return p;
+	}
+
+	std::vector<size_t> degrees(Params p) {
+		std::vector<Edge> edges;
+		generate(p, 0, p.edgeCount(), edges);
+		std::vector<size_t> d(p.vertexCount(), 0);
+		for(auto& e: edges) {
+			d[e.first] += 1;
+			d[e.second] += 1;
+		}
+		return d;
+	}
+}
+
+TEST(GraphGenerators, SlicesMatchWholeEdgeList) {
+	for(auto kind: {Kind::RMAT, Kind::ER, Kind::POWERLAW}) {
+		auto p = paramsFor(kind);
+		std::vector<Edge> whole, sliced;
+		generate(p, 0, p.edgeCount(), whole);
+		generate(p, 0, 100, sliced);
+		generate(p, 100, p.edgeCount(), sliced);
+
+		ASSERT_EQ(whole.size(), p.edgeCount());
+		ASSERT_EQ(whole, sliced);
+		for(auto& e: whole) {
+			ASSERT_LT(e.first, p.vertexCount());
+			ASSERT_LT(e.second, p.vertexCount());
+		}
+	}
+}
+
+TEST(GraphGenerators, SeedChangesGraph) {
+	auto p = paramsFor(Kind::ER);
+	std::vector<Edge> a, b;
+	generate(p, 0, 100, a);
+	p.seed += 1;
+	generate(p, 0, 100, b);
+	ASSERT_NE(a, b);
+}
+
+TEST(GraphGenerators, PowerLawIsSkewedAndErIsNot) {
+	auto pl = degrees(paramsFor(Kind::POWERLAW));
+	auto er = degrees(paramsFor(Kind::ER));
+	/* average degree is 16 in both */
+	ASSERT_GT(*std::max_element(pl.begin(), pl.end()), 100);
+	ASSERT_LT(*std::max_element(er.begin(), er.end()), 50);
+}
+
+TEST(GraphGenerators, ParsesConfig) {
+	ConfigMap cm = {{KIND_OPT, "powerlaw"}, {SCALE_OPT, "12"}, {EDGE_FACTOR_OPT, "4"}, {EXPONENT_OPT, "2.1"}};
+	auto p = Params::fromConfig(cm);
+	ASSERT_EQ(p.kind, Kind::POWERLAW);
+	ASSERT_EQ(p.scale, 12);
+	ASSERT_EQ(p.edgeFactor, 4);
+	ASSERT_DOUBLE_EQ(p.exponent, 2.1);
+	ASSERT_EQ(p.edgeCount(), 4ULL << 12);
+}
+
+TEST(GraphGenerators, RejectsUnknownGenerator) {
+	ConfigMap cm = {{KIND_OPT, "smallworld"}};
+	ASSERT_ANY_THROW(Params::fromConfig(cm));
+}
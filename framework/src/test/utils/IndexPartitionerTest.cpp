@@ -72,4 +72,23 @@ TEST(IndexPartitioner, IdentifyPartitionWhenExcess) {
 	ASSERT_EQ(IndexPartitioner::get_partition_from_index(N, P, 10), 2);
 	ASSERT_EQ(IndexPartitioner::get_partition_from_index(N, P, 11), 3);
 	ASSERT_EQ(IndexPartitioner::get_partition_from_index(N, P, 13), 3);
-}
\ No newline at end of file
+}
+
+TEST(IndexPartitioner, TableAgreesWithFunctions) {
+	for(int N: {0, 1, 3, 14, 100, 1023, 1024, 4097}) {
+		for(int P: {1, 2, 3, 4, 7, 16, 33}) {
+			IndexPartitioner::PartitionTable table(N, P);
+			ASSERT_EQ(table.getElementCount(), N);
+			ASSERT_EQ(table.getPartitionCount(), P);
+
+			for(int p = 0; p < P; p++) {
+				ASSERT_EQ(table.range(p), IndexPartitioner::get_range_for_partition(N, P, p)) << N << " " << P << " " << p;
+			}
+			for(int i = 0; i < N; i++) {
+				auto p = table.partitionOf(i);
+				ASSERT_GE(i, table.range(p).first) << N << " " << P << " " << i;
+				ASSERT_LT(i, table.range(p).second) << N << " " << P << " " << i;
+			}
+		}
+	}
+}
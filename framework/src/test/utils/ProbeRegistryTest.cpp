@@ -0,0 +1,72 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <utils/ProbeRegistry.h>
+
+TEST(ProbeRegistry, NestsScopes) {
+	auto& r = ProbeRegistry::instance();
+	r.reset();
+
+	for(int i = 0; i < 3; i++) {
+		ScopedProbe outer("level");
+		ScopedProbe inner("exchange");
+	}
+
+	auto& timers = r.getTimers();
+	ASSERT_EQ(timers.size(), 2);
+	ASSERT_EQ(timers.at("level").calls, 3);
+	ASSERT_EQ(timers.at("level/exchange").calls, 3);
+	ASSERT_GE(timers.at("level").total, timers.at("level/exchange").total);
+}
+
+TEST(ProbeRegistry, AttributesCountersToInnermostScope) {
+	auto& r = ProbeRegistry::instance();
+	r.reset();
+
+	r.count("edges", 1);
+	{
+		ScopedProbe p("level");
+		r.count("edges", 2);
+		r.count("edges", 3);
+	}
+
+	auto& counters = r.getCounters();
+	ASSERT_EQ(counters.at("edges"), 1);
+	ASSERT_EQ(counters.at("level/edges"), 5);
+}
+
+TEST(ProbeRegistry, RejectsUnbalancedLeave) {
+	auto& r = ProbeRegistry::instance();
+	r.reset();
+	ASSERT_THROW(r.leave(), std::runtime_error);
+}
+
+TEST(ProbeRegistry, ScopedProbeToleratesUnbalancedLeave) {
+	auto& r = ProbeRegistry::instance();
+	r.reset();
+	{
+		ScopedProbe p("level");
+		r.leave();
+	}
+	ASSERT_EQ(r.getTimers().at("level").calls, 1);
+	ASSERT_TRUE(r.currentPhase().empty());
+}
+
+TEST(ProbeRegistry, SerializesToJson) {
+	ReducedProbes reduced;
+	reduced.ranks = 2;
+	ReducedValue v;
+	v.min = 1.0;
+	v.max = 3.0;
+	v.avg = 2.0;
+	v.sum = 4.0;
+	reduced.counters["Algorithm/level/\"edges\""] = v;
+
+	auto json = ProbeRegistry::toJson(reduced);
+	ASSERT_NE(json.find("\"ranks\": 2"), std::string::npos);
+	ASSERT_NE(json.find("\"timers_seconds\": {}"), std::string::npos);
+	ASSERT_NE(json.find("\"Algorithm/level/\\\"edges\\\"\": {\"min\": 1, \"max\": 3, \"avg\": 2, \"sum\": 4}"),
+	          std::string::npos);
+}
@@ -0,0 +1,36 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <utils/Statistics.h>
+
+TEST(Statistics, SummarizesOddSeries) {
+	auto s = Statistics::summarize({5.0, 1.0, 3.0, 2.0, 4.0});
+	ASSERT_DOUBLE_EQ(s.min, 1.0);
+	ASSERT_DOUBLE_EQ(s.firstQuartile, 2.0);
+	ASSERT_DOUBLE_EQ(s.median, 3.0);
+	ASSERT_DOUBLE_EQ(s.thirdQuartile, 4.0);
+	ASSERT_DOUBLE_EQ(s.max, 5.0);
+	ASSERT_DOUBLE_EQ(s.mean, 3.0);
+	ASSERT_NEAR(s.stddev, 1.5811388, 1e-6);
+}
+
+TEST(Statistics, InterpolatesQuartiles) {
+	auto s = Statistics::summarize({1.0, 2.0, 3.0, 4.0});
+	ASSERT_DOUBLE_EQ(s.firstQuartile, 1.75);
+	ASSERT_DOUBLE_EQ(s.median, 2.5);
+	ASSERT_DOUBLE_EQ(s.thirdQuartile, 3.25);
+}
+
+TEST(Statistics, HarmonicMean) {
+	auto s = Statistics::summarizeHarmonic({1.0, 2.0, 4.0});
+	ASSERT_NEAR(s.mean, 3.0/1.75, 1e-9);
+	ASSERT_DOUBLE_EQ(s.median, 2.0);
+}
+
+TEST(Statistics, SingleValueHasNoDeviation) {
+	auto s = Statistics::summarizeHarmonic({7.0});
+	ASSERT_DOUBLE_EQ(s.mean, 7.0);
+	ASSERT_DOUBLE_EQ(s.stddev, 0.0);
+}
@@ -0,0 +1,40 @@
+//
+// Created by blueeyedhush on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <utils/VariableLengthBufferManager.h>
+
+TEST(VariableLengthBufferManager, ReusesBufferWhenItFits) {
+	VariableLengthBufferManager<int> m;
+	int *b = m.getBuffer(100);
+	ASSERT_EQ(m.getCapacity(), 100);
+	ASSERT_EQ(m.getBuffer(10), b);
+	ASSERT_EQ(m.getBuffer(100), b);
+	ASSERT_EQ(m.getCapacity(), 100);
+}
+
+TEST(VariableLengthBufferManager, GrowsGeometrically) {
+	VariableLengthBufferManager<int> m;
+	m.getBuffer(100);
+	m.getBuffer(101);
+	ASSERT_EQ(m.getCapacity(), 200);
+	m.getBuffer(1000);
+	ASSERT_EQ(m.getCapacity(), 1000);
+}
+
+TEST(VariableLengthBufferManager, SlotsAreIndependent) {
+	VariableLengthBufferManager<int> m(2);
+	int *first = m.getBuffer(10, 0);
+	int *second = m.getBuffer(50, 1);
+	ASSERT_NE(first, second);
+	ASSERT_EQ(m.getCapacity(0), 10);
+	ASSERT_EQ(m.getCapacity(1), 50);
+	ASSERT_EQ(m.getCurrentBuffer(0), first);
+	ASSERT_EQ(m.getCurrentBuffer(1), second);
+}
+
+TEST(VariableLengthBufferManager, EmptyMessagesGetValidBuffer) {
+	VariableLengthBufferManager<int> m;
+	ASSERT_NE(m.getBuffer(0), nullptr);
+}
@@ -1,101 +1,378 @@
-
 #include <cstdlib>
 #include <cstdint>
-#include <unordered_map>
-#include <unordered_set>
-#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <iostream>
-#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ * Generates Erdos-Renyi-like graphs (G(n, m) with m ~ n*edges_per_vertex/2) for the framework.
+ *
+ * Every vertex u draws about edges_per_vertex/2 neighbours uniformly from the whole vertex range, using random stream
+ * seeded only by (seed, u) - so the graph depends on seed, but not on number of threads. Each drawn edge is emitted in
+ * both directions (graphs for framework are required to: for each (u, v) in G: (v, u) in G).
+ *
+ * Memory is bounded: in the first phase threads generate edges for their vertex ranges and spill them to temporary run
+ * files, bucketed by source vertex range. In the second one, buckets (each small enough to fit into its share of the
+ * budget) are sorted, deduplicated and formatted in parallel into part files, which are finally concatenated in order.
+ *
+ * badj is a binary CSR (native endianness):
+ *   uint64 vertex_count, uint64 edge_count, uint64 offsets[vertex_count + 1], uint32 neighbours[edge_count]
+ * neighbours of v are neighbours[offsets[v]] .. neighbours[offsets[v+1] - 1]
+ */
 
 typedef uint32_t TVertexId;
+typedef std::pair<TVertexId, TVertexId> Edge;
+
+struct Options {
+	TVertexId v_count = 0;
+	size_t edges_per_vertex = 0;
+	uint64_t seed = 6537;
+	unsigned int threads = 1;
+	size_t mem_mb = 1024;
+	bool adjl = true;
+	bool elt = true;
+	bool badj = false;
+	std::string tmp_dir = ".";
+	std::string name;
+};
+
+namespace {
+	const size_t IO_BUFFER_SIZE = 8*1024*1024;
+
+	/* splitmix64 - cheap generator with 64 bit state, so that it can be seeded per vertex */
+	class VertexRandom {
+	public:
+		VertexRandom(uint64_t seed, TVertexId v) : state(seed ^ (static_cast<uint64_t>(v)*0xD1B54A32D192ED03ULL)) {}
+
+		uint64_t next() {
+			uint64_t x = (state += 0x9E3779B97F4A7C15ULL);
+			x = (x ^ (x >> 30))*0xBF58476D1CE4E5B9ULL;
+			x = (x ^ (x >> 27))*0x94D049BB133111EBULL;
+			return x ^ (x >> 31);
+		}
+
+		/* uniform in [0, bound) */
+		uint64_t next_below(uint64_t bound) {
+			return static_cast<uint64_t>((static_cast<unsigned __int128>(next())*bound) >> 64);
+		}
+
+	private:
+		uint64_t state;
+	};
+
+	FILE* open_or_die(const std::string& path, const char* mode) {
+		FILE* f = fopen(path.c_str(), mode);
+		if (f == nullptr) throw std::runtime_error("Cannot open " + path + ": " + strerror(errno));
+		return f;
+	}
+
+	void write_or_die(const void* data, size_t size, size_t count, FILE* f) {
+		if (count > 0 && fwrite(data, size, count, f) != count) throw std::runtime_error("Write failed");
+	}
+
+	std::string run_path(const Options& o, size_t bucket, unsigned int thread) {
+		return o.tmp_dir + "/" + o.name + ".b" + std::to_string(bucket) + ".t" + std::to_string(thread) + ".run";
+	}
+
+	std::string part_path(const Options& o, size_t bucket, const std::string& ext) {
+		return o.tmp_dir + "/" + o.name + ".b" + std::to_string(bucket) + "." + ext + ".part";
+	}
 
-class BackEdgeMap {
+	/* appends decimal representation of v */
+	void append_uint(std::vector<char>& out, uint64_t v) {
+		char digits[20];
+		int len = 0;
+		do {
+			digits[len++] = static_cast<char>('0' + v%10);
+			v /= 10;
+		} while (v != 0);
+		while (len > 0) out.push_back(digits[--len]);
+	}
+
+	/* text buffer flushed to file when it grows large */
+	class TextWriter {
+	public:
+		TextWriter(const std::string& path) : f(open_or_die(path, "wb")) { buffer.reserve(IO_BUFFER_SIZE + 64); }
+		~TextWriter() { flush(); fclose(f); }
+
+		std::vector<char>& get() { return buffer; }
+		void maybe_flush() { if (buffer.size() >= IO_BUFFER_SIZE) flush(); }
+		void flush() { write_or_die(buffer.data(), 1, buffer.size(), f); buffer.clear(); }
+
+	private:
+		FILE* f;
+		std::vector<char> buffer;
+	};
+}
+
+class Generator {
 public:
-	void add_back_edge(TVertexId from, TVertexId to) { map[from].insert(to); }
-	std::unordered_set<TVertexId>& get_back_edges(TVertexId v_id) { return map[v_id]; }
-	void forget_vertex(TVertexId v_id) { map.erase(v_id); }
+	Generator(Options o) : o(o) {
+		/* estimate (upper bound) of directed edges, which decides into how many buckets they must be split */
+		uint64_t est_edges = static_cast<uint64_t>(o.v_count)*(o.edges_per_vertex + 1);
+		uint64_t bucket_budget = std::max<uint64_t>(1, o.mem_mb*1024*1024/o.threads/sizeof(Edge));
+		bucket_count = std::max<size_t>(o.threads, (est_edges + bucket_budget - 1)/bucket_budget);
+		bucket_count = std::min<size_t>(bucket_count, std::max<TVertexId>(o.v_count, 1));
 
-	std::unordered_map<TVertexId, std::unordered_set<TVertexId>> map;
-};
+		/* phase one keeps one buffer per (thread, bucket), they get half of the budget */
+		uint64_t spill = o.mem_mb*1024*1024/2/o.threads/bucket_count/sizeof(Edge);
+		spill_edges = static_cast<size_t>(std::max<uint64_t>(1024, std::min<uint64_t>(65536, spill)));
+	}
 
+	void run() {
+		std::cout << "buckets: " << bucket_count << ", threads: " << o.threads << '\n';
 
-void g(TVertexId v_count, size_t edges_per_vertex_soft, std::ofstream& f_adjl, std::ofstream& f_elt, std::mt19937::result_type seed)
-{
-	std::mt19937 gen{std::random_device{}()};
-	auto to_generate_multip = 1.5;
+		run_parallel([this](unsigned int t) { generate(t); });
+		std::cout << "edges generated\n";
 
-	/* write vertex count at the beginning of adjl */
-	f_adjl << v_count << '\n';
-	/* write placeholder for edge count, save file position to replace it later */
-	auto max_e_count = static_cast<size_t>(v_count*edges_per_vertex_soft*(to_generate_multip + 0.1));
-	auto edge_count_spos = f_adjl.tellp();
-	f_adjl << max_e_count << '\n';
-	auto edge_count_epos = f_adjl.tellp();
+		std::atomic<size_t> next_bucket(0);
+		edge_counts.assign(bucket_count, 0);
+		run_parallel([this, &next_bucket](unsigned int /* t */) {
+			for (size_t b = next_bucket++; b < bucket_count; b = next_bucket++) {
+				process_bucket(b);
+			}
+		});
 
-	BackEdgeMap be_map;
+		uint64_t edge_count = 0;
+		for (auto c: edge_counts) edge_count += c;
+		std::cout << "edge_count = " << edge_count << '\n';
 
-	size_t edge_count = 0;
-	TVertexId mask = 0xff;
-	for(TVertexId src_v_id = 0; src_v_id < v_count; src_v_id++) {
-		/* graphs for framework are requred to: for each (u, v) in G: (v, u) in G */
-		/* to avoid duplicates, we only add edges to higher vertex ids */
-		/* we also have to remember back edges - this is handled by BackEdgeMap */
+		concatenate(edge_count);
+	}
 
-		f_adjl << src_v_id << ' ';
+private:
+	Options o;
+	size_t bucket_count;
+	size_t spill_edges;
+	std::vector<uint64_t> edge_counts;
 
-		auto& back_edges = be_map.get_back_edges(src_v_id);
+	void run_parallel(std::function<void(unsigned int)> f) {
+		std::vector<std::thread> workers;
+		for (unsigned int t = 0; t < o.threads; t++) workers.emplace_back(f, t);
+		for (auto& w: workers) w.join();
+	}
+
+	TVertexId range_start(uint64_t part, uint64_t parts) {
+		return static_cast<TVertexId>(static_cast<uint64_t>(o.v_count)*part/parts);
+	}
+
+	size_t bucket_of(TVertexId v) {
+		/* inverse of range_start, corrected for rounding */
+		size_t b = static_cast<size_t>(static_cast<uint64_t>(v)*bucket_count/o.v_count);
+		while (b + 1 < bucket_count && range_start(b + 1, bucket_count) <= v) b++;
+		while (b > 0 && range_start(b, bucket_count) > v) b--;
+		return b;
+	}
 
-		/* generate some additional edges if needed */
-		if (back_edges.size() < edges_per_vertex_soft) {
-			auto to_generate = static_cast<size_t>((edges_per_vertex_soft - back_edges.size())*to_generate_multip);
+	void generate(unsigned int t) {
+		std::vector<std::vector<Edge>> buffers(bucket_count);
 
-			std::uniform_int_distribution<TVertexId> distribution(src_v_id+1, v_count-1);
-			for(size_t i = 0; i < to_generate; i++) {
-				// generate neighbour
-				TVertexId dest_v_id = distribution(gen);
-				back_edges.insert(dest_v_id);
+		auto spill = [&](size_t b) {
+			FILE* f = open_or_die(run_path(o, b, t), "ab");
+			write_or_die(buffers[b].data(), sizeof(Edge), buffers[b].size(), f);
+			fclose(f);
+			buffers[b].clear();
+		};
+		auto emit = [&](TVertexId src, TVertexId dst) {
+			auto b = bucket_of(src);
+			buffers[b].push_back(Edge(src, dst));
+			if (buffers[b].size() >= spill_edges) spill(b);
+		};
 
-				// cache back edge
-				be_map.add_back_edge(dest_v_id, src_v_id);
+		/* each thread creates its run files, even if empty - so that phase two can rely on their existence */
+		for (size_t b = 0; b < bucket_count; b++) fclose(open_or_die(run_path(o, b, t), "wb"));
+
+		TVertexId from = range_start(t, o.threads), to = range_start(t + 1, o.threads);
+		for (TVertexId u = from; u < to; u++) {
+			VertexRandom rnd(o.seed, u);
+			size_t draws = o.edges_per_vertex/2 + (((o.edges_per_vertex & 1) && (rnd.next() & 1)) ? 1 : 0);
+			for (size_t i = 0; i < draws; i++) {
+				auto v = static_cast<TVertexId>(rnd.next_below(o.v_count));
+				if (v == u) continue;
+				emit(u, v);
+				emit(v, u);
 			}
 		}
 
-		/* write all neighbours */
-		for(auto dest: back_edges) {
-			f_adjl << dest << ' ';
-			f_elt << src_v_id << '\t' << dest << '\n';
+		for (size_t b = 0; b < bucket_count; b++) {
+			if (!buffers[b].empty()) spill(b);
+		}
+	}
+
+	void process_bucket(size_t b) {
+		std::vector<Edge> edges;
+		for (unsigned int t = 0; t < o.threads; t++) {
+			auto path = run_path(o, b, t);
+			FILE* f = open_or_die(path, "rb");
+			fseek(f, 0, SEEK_END);
+			auto count = static_cast<size_t>(ftell(f))/sizeof(Edge);
+			fseek(f, 0, SEEK_SET);
+			auto offset = edges.size();
+			edges.resize(offset + count);
+			if (fread(edges.data() + offset, sizeof(Edge), count, f) != count) throw std::runtime_error("Read failed");
+			fclose(f);
+			remove(path.c_str());
 		}
-		edge_count += back_edges.size();
-		be_map.forget_vertex(src_v_id);
 
-		f_adjl << '\n';
+		std::sort(edges.begin(), edges.end());
+		edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+		edge_counts[b] = edges.size();
 
-		if ((src_v_id & mask) == 0)
-			std::cout << src_v_id << "/" << v_count << '\n';
+		TVertexId from = range_start(b, bucket_count), to = range_start(b + 1, bucket_count);
+
+		if (o.adjl) {
+			TextWriter w(part_path(o, b, "adjl"));
+			auto it = edges.begin();
+			for (TVertexId v = from; v < to; v++) {
+				append_uint(w.get(), v);
+				for (; it != edges.end() && it->first == v; ++it) {
+					w.get().push_back(' ');
+					append_uint(w.get(), it->second);
+				}
+				w.get().push_back('\n');
+				w.maybe_flush();
+			}
+		}
+
+		if (o.elt) {
+			TextWriter w(part_path(o, b, "elt"));
+			for (auto& e: edges) {
+				append_uint(w.get(), e.first);
+				w.get().push_back('\t');
+				append_uint(w.get(), e.second);
+				w.get().push_back('\n');
+				w.maybe_flush();
+			}
+		}
+
+		if (o.badj) {
+			std::vector<uint32_t> degrees(to - from, 0);
+			std::vector<TVertexId> neighbours;
+			neighbours.reserve(edges.size());
+			for (auto& e: edges) {
+				degrees[e.first - from] += 1;
+				neighbours.push_back(e.second);
+			}
+
+			FILE* fd = open_or_die(part_path(o, b, "deg"), "wb");
+			write_or_die(degrees.data(), sizeof(uint32_t), degrees.size(), fd);
+			fclose(fd);
+			FILE* fn = open_or_die(part_path(o, b, "nb"), "wb");
+			write_or_die(neighbours.data(), sizeof(TVertexId), neighbours.size(), fn);
+			fclose(fn);
+		}
+
+		printf("bucket %zu/%zu done\n", b + 1, bucket_count);
 	}
 
-	/* write correct edge count */
-	auto placeholder_len = edge_count_epos - edge_count_spos;
-	std::string placeholder(std::to_string(edge_count));
-	while (placeholder.size() < placeholder_len - 1)
-		placeholder.push_back(' ');
-	f_adjl.seekp(edge_count_spos);
-	f_adjl << placeholder << '\n';
+	void append_parts(FILE* out, const std::string& ext) {
+		std::vector<char> buffer(IO_BUFFER_SIZE);
+		for (size_t b = 0; b < bucket_count; b++) {
+			auto path = part_path(o, b, ext);
+			FILE* in = open_or_die(path, "rb");
+			size_t read;
+			while ((read = fread(buffer.data(), 1, buffer.size(), in)) > 0) write_or_die(buffer.data(), 1, read, out);
+			fclose(in);
+			remove(path.c_str());
+		}
+	}
 
-	std::cout << "edge_count = " << edge_count << '\n';
-}
+	void concatenate(uint64_t edge_count) {
+		if (o.adjl) {
+			FILE* f = open_or_die(o.name + ".adjl", "wb");
+			setvbuf(f, nullptr, _IOFBF, IO_BUFFER_SIZE);
+			/* edge count is known at this point, so no placeholder is needed */
+			std::string header = std::to_string(o.v_count) + "\n" + std::to_string(edge_count) + "\n";
+			write_or_die(header.data(), 1, header.size(), f);
+			append_parts(f, "adjl");
+			fclose(f);
+		}
 
-int main(int argc, const char **argv) {
-	if (argc < 3) {
-		printf("Usage: er_gen <vertex_count> <edges_per_vertex>\n");
+		if (o.elt) {
+			FILE* f = open_or_die(o.name + ".elt", "wb");
+			append_parts(f, "elt");
+			fclose(f);
+		}
+
+		if (o.badj) {
+			FILE* f = open_or_die(o.name + ".badj", "wb");
+			setvbuf(f, nullptr, _IOFBF, IO_BUFFER_SIZE);
+			uint64_t header[] = {o.v_count, edge_count};
+			write_or_die(header, sizeof(uint64_t), 2, f);
+
+			/* offsets are prefix sums of degrees */
+			uint64_t offset = 0;
+			write_or_die(&offset, sizeof(uint64_t), 1, f);
+			std::vector<uint32_t> degrees;
+			std::vector<uint64_t> offsets;
+			for (size_t b = 0; b < bucket_count; b++) {
+				auto path = part_path(o, b, "deg");
+				FILE* in = open_or_die(path, "rb");
+				degrees.resize(range_start(b + 1, bucket_count) - range_start(b, bucket_count));
+				if (fread(degrees.data(), sizeof(uint32_t), degrees.size(), in) != degrees.size())
+					throw std::runtime_error("Read failed");
+				fclose(in);
+				remove(path.c_str());
+
+				offsets.clear();
+				for (auto d: degrees) offsets.push_back(offset += d);
+				write_or_die(offsets.data(), sizeof(uint64_t), offsets.size(), f);
+			}
+
+			append_parts(f, "nb");
+			fclose(f);
+		}
+	}
+};
+
+namespace {
+	void usage() {
+		printf("Usage: er_gen <vertex_count> <edges_per_vertex> [--seed N] [--threads N] [--mem-mb N]"
+		       " [--formats adjl,elt,badj] [--tmp DIR]\n");
 		exit(1);
 	}
 
-	TVertexId vCount = std::stoull(argv[1]);
-	size_t edgesPerVertex = std::stoull(argv[2]);
-	std::string graphName("cst_" + std::to_string(vCount) + "_" + std::to_string(edgesPerVertex));
+	Options parse_options(int argc, const char** argv) {
+		if (argc < 3) usage();
+
+		Options o;
+		o.v_count = static_cast<TVertexId>(std::stoull(argv[1]));
+		o.edges_per_vertex = std::stoull(argv[2]);
+		o.threads = std::max(1u, std::thread::hardware_concurrency());
+
+		for (int i = 3; i < argc; i += 2) {
+			if (i + 1 >= argc) usage();
+			std::string key(argv[i]), value(argv[i+1]);
+
+			if (key == "--seed") o.seed = std::stoull(value);
+			else if (key == "--threads") o.threads = std::max(1u, static_cast<unsigned int>(std::stoul(value)));
+			else if (key == "--mem-mb") o.mem_mb = std::max<size_t>(1, std::stoull(value));
+			else if (key == "--tmp") o.tmp_dir = value;
+			else if (key == "--formats") {
+				o.adjl = value.find("adjl") != std::string::npos;
+				o.elt = value.find("elt") != std::string::npos;
+				o.badj = value.find("badj") != std::string::npos;
+			}
+			else usage();
+		}
+
+		o.threads = std::min<unsigned int>(o.threads, std::max<TVertexId>(o.v_count, 1));
+		o.name = "cst_" + std::to_string(o.v_count) + "_" + std::to_string(o.edges_per_vertex);
+		return o;
+	}
+}
+
+int main(int argc, const char **argv) {
+	Options o = parse_options(argc, argv);
+	if (o.v_count == 0) usage();
 
-	std::ofstream adjl(graphName + ".adjl");
-	std::ofstream elt(graphName + ".elt");
-	g(vCount, edgesPerVertex, adjl, elt, 6537);
-}
\ No newline at end of file
+	Generator(o).run();
+}